@@ -5,33 +5,213 @@
 
 #include "bignum/decimal.hh"
 
-// bignum
-#include "bignum/nth_power_of_ten.hh"
+// Standard C++
+#include <algorithm>
+#include <vector>
 
+// iota
+#include "iota/endian.hh"
+
+// math
+#include "math/integer.hh"
+
+
+/*
+	Conversion works in chunks of nine decimal digits, since 10^9 is the
+	largest power of ten that fits in a twig.  Small values are converted
+	one chunk at a time by short multiplication or division of the limbs.
+	Larger ones are split in two around 10^(9 * 2^k), and the halves are
+	converted recursively, which lets decoding benefit from Karatsuba
+	multiplication and replaces many short divisions with one long one
+	in encoding.  The powers 10^(9 * 2^k) are cached, since each one is
+	the square of the one before.
+*/
 
 namespace bignum
 {
 	
 	using plus::string;
 	
+	using math::integer::limb_t;
+	using math::integer::twig_t;
 	
-	static inline
-	bool abs_lte( const integer& a, const integer& b )
+	typedef std::vector< limb_t > limb_vector;
+	
+	const unsigned chunk_digits = 9;
+	
+	const twig_t chunk_modulus = 1000000000;
+	
+	// Above these sizes (in digits), splitting is faster.
+	
+	const unsigned decode_split_threshold = 2000;
+	const unsigned encode_split_threshold =  600;
+	
+	
+	static std::vector< integer > memoized_chunk_powers;
+	
+	static
+	const integer& chunk_power( unsigned k )
 	{
-		return abs_compare( a, b ) <= 0;
+		// Returns 10^(9 * 2^k).
+		
+		if ( memoized_chunk_powers.empty() )
+		{
+			memoized_chunk_powers.push_back( chunk_modulus );
+		}
+		
+		while ( k >= memoized_chunk_powers.size() )
+		{
+			integer x = memoized_chunk_powers.back();
+			
+			x *= x;
+			
+			memoized_chunk_powers.push_back( x );
+		}
+		
+		return memoized_chunk_powers[ k ];
+	}
+	
+	static
+	integer power_of_ten( unsigned long n )
+	{
+		twig_t small = 1;
+		
+		for ( unsigned i = n % chunk_digits;  i > 0;  --i )
+		{
+			small *= 10;
+		}
+		
+		integer result = small;
+		
+		n /= chunk_digits;
+		
+		for ( unsigned k = 0;  n != 0;  ++k, n >>= 1 )
+		{
+			if ( n & 1 )
+			{
+				result *= chunk_power( k );
+			}
+		}
+		
+		return result;
 	}
 	
 	static inline
-	bool abs_gte( const integer& a, const integer& b )
+	unsigned split_level( unsigned n_digits )
+	{
+		// Returns the greatest k such that 9 * 2^k < n_digits.
+		
+		unsigned k = 0;
+		
+		while ( chunk_digits << (k + 1) < n_digits )
+		{
+			++k;
+		}
+		
+		return k;
+	}
+	
+	static
+	twig_t decode_chunk( const char* p, unsigned n )
 	{
-		return abs_compare( a, b ) >= 0;
+		twig_t result = 0;
+		
+		while ( n-- > 0 )
+		{
+			result = result * 10 + (*p++ - '0');
+		}
+		
+		return result;
 	}
 	
+	static
+	integer decode_chunks( const char* p, unsigned n )
+	{
+		const bool le = iota::is_little_endian();
+		
+		const unsigned limb_bits = sizeof (limb_t) * 8;
+		
+		// Each chunk of nine digits needs fewer than 30 bits.
+		
+		const unsigned capacity = ((n / chunk_digits + 1) * 30) / limb_bits + 1;
+		
+		limb_vector limbs( capacity );
+		
+		limb_t* low = le ? &limbs[ 0 ] : &limbs[ capacity - 1 ];
+		
+		unsigned size = 1;
+		
+		unsigned chunk_size = n % chunk_digits;
+		
+		if ( chunk_size == 0 )
+		{
+			chunk_size = chunk_digits;
+		}
+		
+		twig_t m = 1;
+		
+		for ( unsigned i = 0;  i < chunk_size;  ++i )
+		{
+			m *= 10;
+		}
+		
+		while ( n > 0 )
+		{
+			using math::integer::multiply_add;
+			
+			const twig_t chunk = decode_chunk( p, chunk_size );
+			
+			if ( twig_t carry = multiply_add( le, low, size, m, chunk ) )
+			{
+				if ( le )
+				{
+					low[ size ] = carry;
+				}
+				else
+				{
+					*--low = carry;
+				}
+				
+				++size;
+			}
+			
+			p += chunk_size;
+			n -= chunk_size;
+			
+			chunk_size = chunk_digits;
+			
+			m = chunk_modulus;
+		}
+		
+		return integer( low, size );
+	}
 	
-	integer decode_decimal( const char* p, unsigned n )
+	static
+	integer decode_digits( const char* p, unsigned n )
 	{
-		integer result;
+		if ( n < decode_split_threshold )
+		{
+			return decode_chunks( p, n );
+		}
+		
+		const unsigned k = split_level( n );
+		
+		const unsigned low_digits = chunk_digits << k;
+		
+		integer result = decode_digits( p, n - low_digits );
 		
+		if ( ! result.is_zero() )
+		{
+			result *= chunk_power( k );
+		}
+		
+		result += decode_digits( p + n - low_digits, low_digits );
+		
+		return result;
+	}
+	
+	integer decode_decimal( const char* p, unsigned n )
+	{
 		bool negative = false;
 		
 		if ( n != 0 )
@@ -52,16 +232,14 @@ namespace bignum
 			}
 		}
 		
-		while ( n-- )
+		while ( n > 0  &&  *p == '0' )
 		{
-			if ( char c = *p++ - '0' )
-			{
-				integer digit = c;
-			
-				result += nth_power_of_ten( n ) * digit;
-			}
+			++p;
+			--n;
 		}
 		
+		integer result = decode_digits( p, n );
+		
 		if ( negative )
 		{
 			result.invert();
@@ -70,16 +248,67 @@ namespace bignum
 		return result;
 	}
 	
+	static
+	unsigned long bit_length( const integer& x )
+	{
+		// x is nonzero.
+		
+		const unsigned limb_bits = sizeof (limb_t) * 8;
+		
+		const integer::size_type size = x.size();
+		
+		limb_t const* data = (limb_t const*) x.buffer().data();
+		
+		limb_t top = iota::is_little_endian() ? data[ size - 1 ] : data[ 0 ];
+		
+		unsigned long n = (size - 1) * (unsigned long) limb_bits;
+		
+		while ( top != 0 )
+		{
+			top >>= 1;
+			++n;
+		}
+		
+		return n;
+	}
+	
 	static string::size_type count_decimal_digits( const integer& x )
 	{
-		string::size_type power = 0;
+		if ( x.size() <= 1 )
+		{
+			limb_t magnitude = x.clipped();
+			
+			string::size_type n = 0;
+			
+			while ( magnitude != 0 )
+			{
+				magnitude /= 10;
+				++n;
+			}
+			
+			return n;
+		}
+		
+		/*
+			An x of b bits has at least 1 + floor( (b - 1) * log10(2) )
+			digits, and at most one more.  The multiplier is a lower bound
+			for log10(2).
+		*/
 		
-		while ( abs_lte( nth_power_of_ten( power ), x ) )
+		const unsigned long long b = bit_length( x );
+		
+		string::size_type n = (b - 1) * 301029995ull / 1000000000ull + 1;
+		
+		integer power = power_of_ten( n );
+		
+		while ( abs_compare( power, x ) <= 0 )
 		{
-			++power;
+			power *= 10;
+			
+			++n;
 		}
 		
-		return power;
+		return n;
 	}
 	
 	string::size_type decimal_length( const integer& x )
@@ -88,6 +317,85 @@ namespace bignum
 	}
 	
 	
+	static
+	void encode_chunks( char* begin, char* end, const integer& x )
+	{
+		// Writes x right-aligned in [begin, end), padded with zeros.
+		
+		const bool le = iota::is_little_endian();
+		
+		limb_t const* data = (limb_t const*) x.buffer().data();
+		
+		unsigned size = x.size();
+		
+		limb_vector limbs( data, data + size );
+		
+		limb_t* low = size ? &limbs[ 0 ] : 0;  // NULL
+		
+		char* p = end;
+		
+		while ( size > 0 )
+		{
+			using math::integer::divide_short;
+			
+			twig_t chunk = divide_short( le, low, size, chunk_modulus );
+			
+			for ( unsigned i = 0;  i < chunk_digits  &&  p > begin;  ++i )
+			{
+				*--p = '0' + chunk % 10;
+				
+				chunk /= 10;
+			}
+			
+			if ( (le ? low[ size - 1 ] : low[ 0 ]) == 0 )
+			{
+				low += ! le;
+				
+				--size;
+			}
+		}
+		
+		std::fill( begin, p, '0' );
+	}
+	
+	static
+	void encode_digits( char* begin, char* end, const integer& x )
+	{
+		// x is nonnegative and has at most end - begin digits.
+		
+		const unsigned n = end - begin;
+		
+		if ( n < encode_split_threshold )
+		{
+			encode_chunks( begin, end, x );
+			
+			return;
+		}
+		
+		const unsigned k = split_level( n );
+		
+		char* const mid = end - (chunk_digits << k);
+		
+		const integer divisor = chunk_power( k );
+		
+		if ( abs_compare( x, divisor ) < 0 )
+		{
+			std::fill( begin, mid, '0' );
+			
+			encode_digits( mid, end, x );
+			
+			return;
+		}
+		
+		integer remainder = x;
+		integer quotient;
+		
+		remainder.divide_by( divisor, quotient );
+		
+		encode_digits( begin, mid, quotient  );
+		encode_digits( mid,   end, remainder );
+	}
+	
 	static
 	char* encode_decimal( char* r, string::size_type n, const integer& x )
 	{
@@ -112,22 +420,9 @@ namespace bignum
 			*r++ = '-';
 		}
 		
-		while ( n-- > 0 )
-		{
-			const integer& x10 = nth_power_of_ten( n );
-			
-			int i = 0;
-			
-			while ( abs_gte( remains, x10 ) )
-			{
-				remains -= x10;
-				++i;
-			}
-			
-			*r++ = '0' + i;
-		}
+		encode_digits( r, r + n, remains );
 		
-		return r;
+		return r + n;
 	}
 	
 	char* encode_decimal( char* r, const integer& x )
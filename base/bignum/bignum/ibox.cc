@@ -477,12 +477,24 @@ namespace bignum
 		{
 			its.integer = product;
 		}
+		else if ( its.size == y.its.size  &&  its.integer == y.its.integer )
+		{
+			// Same extent (or same small integer), so same magnitude.
+			
+			using math::integer::square;
+			
+			const size_t x_size = size() * 2;
+			
+			extend( x_size );
+			
+			square( iota::is_little_endian(), its.pointer, x_size );
+			
+			shrink_to_fit();
+		}
 		else
 		{
 			using math::integer::multiply;
 			
-			ibox tmp = y;  // in case this == &y
-			
 			size_t x_size = size();
 			size_t y_size = y.size();
 			
@@ -491,7 +503,7 @@ namespace bignum
 			extend( x_size );
 			
 			limb_t*       x_data = its.pointer;
-			limb_t const* y_data = tmp.data();
+			limb_t const* y_data = y.data();
 			
 			multiply( iota::is_little_endian(),
 			          x_data, x_size,
@@ -503,6 +515,67 @@ namespace bignum
 		its.sign *= y.its.sign;
 	}
 	
+	void ibox::divide_by( const ibox& y, ibox& quotient )
+	{
+		ASSERT( y.its.sign != 0 );
+		
+		ASSERT( abs_compare( *this, y ) >= 0 );
+		
+		if ( ! has_extent() )
+		{
+			// Both operands fit in a limb.
+			
+			const limb_t divisor = y.its.integer;
+			
+			quotient = ibox( (unsigned long) (its.integer / divisor) );
+			
+			const sign_t sign = its.sign;
+			
+			construct( (unsigned long) (its.integer % divisor) );
+			
+			if ( its.integer != 0 )
+			{
+				its.sign = sign;
+			}
+			
+			return;
+		}
+		
+		using math::integer::divide;
+		
+		ibox tmp = y;  // in case this == &y
+		
+		unshare();
+		
+		const size_t x_size = its.size;
+		
+		ibox q;
+		
+		q.its.pointer = (ptr_t) extent_alloc( x_size * sizeof (int_t) );
+		q.its.size    = x_size;
+		q.its.sign    = Sign_positive;
+		
+		divide( iota::is_little_endian(),
+		        its.pointer, x_size,
+		        tmp.data(), tmp.size(),
+		        q.its.pointer );
+		
+		q.shrink_to_fit();
+		
+		quotient.swap( q );
+		
+		if ( std::count( its.pointer, its.pointer + x_size, 0 ) == x_size )
+		{
+			destroy_extent();
+			
+			construct( 0ul );
+		}
+		else
+		{
+			shrink_to_fit();
+		}
+	}
+	
 	void ibox::halve()
 	{
 		if ( has_extent() )
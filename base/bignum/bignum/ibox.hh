@@ -240,6 +240,9 @@ namespace bignum
 			
 			void multiply_by( const ibox& y );
 			
+			// Requires |*this| >= |y| > 0, and leaves the remainder in *this.
+			void divide_by( const ibox& y, ibox& quotient );
+			
 			void halve();
 			
 			unsigned long area() const;
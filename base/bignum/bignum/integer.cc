@@ -5,9 +5,6 @@
 
 #include "bignum/integer.hh"
 
-// relix-compat
-#include "relix/recurse.hh"
-
 
 namespace bignum
 {
@@ -51,76 +48,14 @@ namespace bignum
 		return x;
 	}
 	
-/*	
-	It's very unfortunate that we have to specify the exact instantiation of
-	relix::recurse<>(), but if we don't, then Metrowerks C++ will infer type
-	`const integer` instead of `const integer&` and generate useless copies.
-*/
-	
-	template < class F >
-	static inline void recurse( F f, const integer& a, integer& b, integer& c )
-	{
-		typedef const integer&  A;
-		typedef       integer&  B;
-		typedef       integer&  C;
-		
-		relix::recurse< void, A, A, B, B, C, C >( f, a, b, c );
-	}
-	
 /*
-	The internal division routine leaves the remainder in the `dividend`
-	parameter.  If the divisor exceeds the dividend, it does nothing.
-	Otherwise, it recursively calls itself with a doubled divisor and then
-	doubles the resulting quotient.  If the remainder exceeds or equals the
-	divisor, it subtracts the divisor from the remainder and increments the
-	quotient.
-	
-	Since the difference in magnitude between the dividend and the divisor
-	(which is the only limit on the recursion depth) can be especially large
-	(over 260,000 for a 32-bit limb and 16-bit count (if division by 2 isn't
-	optimized)), we need to make sure that we don't destroy the system by
-	overrunning the stack.  Assuming a 64-byte stack frame, the worst case
-	for division will require sixteen megabytes.  Modern operating systems
-	will either page memory onto the end of the stack on demand, or kill the
-	process (either of which is an acceptable outcome from this library's
-	perspective -- if you want to perform division on numbers that only fit
-	in hundreds of kilobytes, it's on you to make sure your OS is up to it,
-	e.g. via ulimit).
-	
-	Less capable operating systems are at high risk, however.  If a program
-	running in MacRelix in classic Mac OS runs off the end of the stack, it
-	could not only corrupt or crash the entire MacRelix process, but even
-	the whole underlying Mac OS system, possibly requiring a hard reset.
-	
-	To mitigate this, we recurse indirectly through relix::recurse(), which
-	checks the available stack space, and if it's running low, allocates a
-	new stack and switches to it before calling the recursive function.
-	(The memory allocation can fail, of course, in which case SIGSTKFLT is
-	generated, and the process is killed unless it catches the signal.)
+	Division that can't be done in a single machine word is done by Knuth's
+	Algorithm D (see math/integer.cc), in time proportional to the product
+	of the quotient and divisor lengths.  It leaves the remainder in the
+	dividend.  (It used to be done by recursively doubling the divisor,
+	which took quadratic time in the difference of the operand lengths.)
 */
 	
-	static
-	void divide( const integer&  divisor,
-	             integer&        dividend,
-	             integer&        quotient )
-	{
-		if ( abs_compare( dividend, divisor ) >= 0 )
-		{
-			recurse( &divide, divisor + divisor, dividend, quotient );
-			
-			quotient += quotient;
-			
-			if ( abs_compare( dividend, divisor ) >= 0 )
-			{
-				++quotient;
-				
-				dividend -= divisor;
-			}
-		}
-		
-		// remainder is in `dividend`
-	}
-	
 	static inline
 	bool builtin_division_usable( const integer& divisor,
 	                              const integer& dividend )
@@ -146,7 +81,7 @@ namespace bignum
 		}
 		else
 		{
-			// 3-arg divide() requires its inputs to have the same sign.
+			// Divide magnitudes, with the dividend's sign matching the divisor's.
 			
 			const bool was_negative = dividend.is_negative();
 			
@@ -163,9 +98,9 @@ namespace bignum
 				dividend = divid % divis;  // remainder
 				quotient = divid / divis;
 			}
-			else
+			else if ( abs_compare( dividend, divisor ) >= 0 )
 			{
-				divide( divisor, dividend, quotient );
+				dividend.divide_by( divisor, quotient );
 			}
 			
 			/*
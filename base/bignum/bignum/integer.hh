@@ -83,6 +83,13 @@ namespace bignum
 			template < class Int >  bool demotes_to() const;
 			
 			void halve()   { box.halve();  }
+			
+			// Requires |*this| >= |divisor| > 0.  See divide() in integer.cc.
+			void divide_by( const integer& divisor, integer& quotient )
+			{
+				box.divide_by( divisor.box, quotient.box );
+			}
+			
 			void invert()  { box.invert(); }
 			
 			void absolve()  { if ( is_negative() )  invert(); }
@@ -0,0 +1,216 @@
+/*
+	bench/find.cc
+	-------------
+*/
+
+// Standard C
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// gear
+#include "gear/find.hh"
+
+
+/*
+	Compare gear's searches with the byte-at-a-time loops they replaced,
+	on a buffer of several megabytes of 60-column text.  Each search is
+	run in two ways:  once per line (as text_input::feed does), and once
+	across the whole buffer for a byte that doesn't occur.
+*/
+
+#define PROGRAM  "find"
+
+static const unsigned long buffer_size = 8 * 1024 * 1024;
+
+static const int n_runs = 5;
+
+
+static const char* naive_first( const char* p, const char* end, char c )
+{
+	for ( ;  p != end;  ++p )
+	{
+		if ( *p == c )
+		{
+			return p;
+		}
+	}
+	
+	return 0;  // NULL
+}
+
+static const char* naive_last( const char* p, const char* end, char c )
+{
+	while ( end != p )
+	{
+		if ( *--end == c )
+		{
+			return end;
+		}
+	}
+	
+	return 0;  // NULL
+}
+
+static bool naive_matches( char c, const unsigned char* chars )
+{
+	for ( int n = *chars++;  n != 0;  --n )
+	{
+		if ( c == char( *chars++ ) )
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+static const char* naive_first( const char* p, const char* end, const unsigned char* chars )
+{
+	for ( ;  p != end;  ++p )
+	{
+		if ( naive_matches( *p, chars ) )
+		{
+			return p;
+		}
+	}
+	
+	return 0;  // NULL
+}
+
+static const char* gear_first( const char* p, const char* end, char c )
+{
+	return gear::find_first_match( p, end, c );
+}
+
+static const char* gear_last( const char* p, const char* end, char c )
+{
+	return gear::find_last_match( p, end, c );
+}
+
+static const char* gear_first( const char* p, const char* end, const unsigned char* chars )
+{
+	return gear::find_first_match( p, end, chars );
+}
+
+
+static char* buffer;
+static char* buffer_end;
+
+static unsigned long checksum;
+
+static void fill_buffer()
+{
+	buffer = (char*) malloc( buffer_size );
+	
+	if ( buffer == 0 )  // NULL
+	{
+		fprintf( stderr, PROGRAM ": out of memory\n" );
+		
+		exit( 1 );
+	}
+	
+	buffer_end = buffer + buffer_size;
+	
+	const char text[] = "The quick brown fox jumps over the lazy dog; ";
+	
+	for ( unsigned long i = 0;  i < buffer_size;  ++i )
+	{
+		buffer[ i ] = i % 61 == 60 ? '\n' : text[ i % (sizeof text - 1) ];
+	}
+}
+
+template < class Target >
+static void each_line( const char* (*f)( const char*, const char*, Target ), Target t )
+{
+	const char* p = buffer;
+	
+	while ( const char* q = f( p, buffer_end, t ) )
+	{
+		checksum += q - p;
+		
+		p = q + 1;
+	}
+}
+
+template < class Target >
+static void whole_buffer( const char* (*f)( const char*, const char*, Target ), Target t )
+{
+	checksum += f( buffer, buffer_end, t ) != 0;
+}
+
+static double best_time( void (*run)() )
+{
+	double best = 0;
+	
+	for ( int i = 0;  i < n_runs;  ++i )
+	{
+		const clock_t start = clock();
+		
+		run();
+		
+		const double elapsed = double( clock() - start ) / CLOCKS_PER_SEC;
+		
+		if ( i == 0  ||  elapsed < best )
+		{
+			best = elapsed;
+		}
+	}
+	
+	return best;
+}
+
+static const unsigned char eol[] = "\x02" "\r\n";
+static const unsigned char punct[] = "\x08" ".,;:!?\r\n";
+
+static void naive_lines()      { each_line( &naive_first, '\n' ); }
+static void gear_lines()       { each_line( &gear_first,  '\n' ); }
+static void naive_absent()     { whole_buffer( &naive_first, '\0' ); }
+static void gear_absent()      { whole_buffer( &gear_first,  '\0' ); }
+static void naive_absent_r()   { whole_buffer( &naive_last, '\0' ); }
+static void gear_absent_r()    { whole_buffer( &gear_last,  '\0' ); }
+static void naive_eol_lines()  { each_line( &naive_first, eol ); }
+static void gear_eol_lines()   { each_line( &gear_first,  eol ); }
+static void naive_punct()      { each_line( &naive_first, punct ); }
+static void gear_punct()       { each_line( &gear_first,  punct ); }
+
+struct benchmark
+{
+	const char*  name;
+	void         (*naive)();
+	void         (*gear)();
+};
+
+static const benchmark benchmarks[] =
+{
+	{ "'\\n' per line        ", &naive_lines,     &gear_lines     },
+	{ "absent byte, forward ", &naive_absent,    &gear_absent    },
+	{ "absent byte, backward", &naive_absent_r,  &gear_absent_r  },
+	{ "\"\\r\\n\" per line      ", &naive_eol_lines, &gear_eol_lines },
+	{ "8-char set per match ", &naive_punct,     &gear_punct     },
+};
+
+int main( int argc, const char *const *argv )
+{
+	fill_buffer();
+	
+	printf( "%lu MiB, best of %d runs, MB/s:\n", buffer_size >> 20, n_runs );
+	printf( "                        before   after\n" );
+	
+	const int n = sizeof benchmarks / sizeof benchmarks[ 0 ];
+	
+	for ( int i = 0;  i < n;  ++i )
+	{
+		const benchmark& b = benchmarks[ i ];
+		
+		const double mb = buffer_size / 1e6;
+		
+		const double before = best_time( b.naive );
+		const double after  = best_time( b.gear  );
+		
+		printf( "%s  %6.0f  %6.0f\n", b.name, mb / before, mb / after );
+	}
+	
+	return checksum == 0;
+}
@@ -9,12 +9,50 @@
 #include <string.h>
 
 
+/*
+	Single-byte searches examine a machine word at a time:  XORing a word
+	with the target byte repeated in each position leaves a zero byte
+	wherever the target occurs, and (x - 0x0101...) & ~x & 0x8080... is
+	nonzero if and only if x has a zero byte.  Only a word that passes the
+	test (or, for a negated search, a word that isn't entirely zero) gets
+	scanned byte by byte.  Words are read only between aligned boundaries
+	within the range, so nothing outside it is touched.
+	
+	Char-set searches look each byte up in a 256-bit map of the set,
+	instead of scanning the set for every byte.
+*/
+
 namespace gear
 {
 	
-	static inline bool char_matches( char a, char b )
+	typedef unsigned long word_t;
+	
+	const word_t ones = word_t( -1 ) / 0xFF;  // 0x0101...
+	const word_t highs = ones << 7;           // 0x8080...
+	
+	static inline
+	bool is_aligned( const char* p )
 	{
-		return a == b;
+		return ((unsigned long) p & (sizeof (word_t) - 1)) == 0;
+	}
+	
+	static inline
+	word_t load_word( const char* p )
+	{
+		word_t word;
+		
+		memcpy( &word, p, sizeof word );
+		
+		return word;
+	}
+	
+	static inline
+	bool word_is_interesting( word_t x, bool negated )
+	{
+		// x is a word XORed with the target byte in each position.
+		
+		return negated ? x != 0
+		               : ((x - ones) & ~x & highs) != 0;
 	}
 	
 	const char* find_first_match( const char*  p,
@@ -23,9 +61,31 @@ namespace gear
 	                              const char*  _default,
 	                              bool         negated )
 	{
+		const word_t pattern = ones * (unsigned char) c;
+		
+		while ( p != end  &&  ! is_aligned( p ) )
+		{
+			if ( (*p == c) - negated )
+			{
+				return p;
+			}
+			
+			++p;
+		}
+		
+		while ( end - p >= (long) sizeof (word_t) )
+		{
+			if ( word_is_interesting( load_word( p ) ^ pattern, negated ) )
+			{
+				break;
+			}
+			
+			p += sizeof (word_t);
+		}
+		
 		for ( ;  p != end;  ++p )
 		{
-			if ( char_matches( *p, c ) - negated )
+			if ( (*p == c) - negated )
 			{
 				return p;
 			}
@@ -40,13 +100,35 @@ namespace gear
 	                             const char*  _default,
 	                             bool         negated )
 	{
+		const word_t pattern = ones * (unsigned char) c;
+		
 		const char* begin = p;
 		
 		p = end;
 		
+		while ( p != begin  &&  ! is_aligned( p ) )
+		{
+			if ( (*--p == c) - negated )
+			{
+				return p;
+			}
+		}
+		
+		while ( p - begin >= (long) sizeof (word_t) )
+		{
+			const word_t word = load_word( p - sizeof (word_t) );
+			
+			if ( word_is_interesting( word ^ pattern, negated ) )
+			{
+				break;
+			}
+			
+			p -= sizeof (word_t);
+		}
+		
 		while ( p != begin )
 		{
-			if ( char_matches( *--p, c ) - negated )
+			if ( (*--p == c) - negated )
 			{
 				return p;
 			}
@@ -56,18 +138,31 @@ namespace gear
 	}
 	
 	
-	static bool char_matches( char c, const unsigned char* chars )
+	class char_map
 	{
-		for ( int n = *chars++;  n != 0;  --n )
-		{
-			if ( c == char( *chars++ ) )
+		private:
+			unsigned char its_bits[ 256 / 8 ];
+		
+		public:
+			char_map( const unsigned char* chars )
 			{
-				return true;
+				memset( its_bits, '\0', sizeof its_bits );
+				
+				for ( int n = *chars++;  n != 0;  --n )
+				{
+					const unsigned char c = *chars++;
+					
+					its_bits[ c >> 3 ] |= 1 << (c & 7);
+				}
 			}
-		}
-		
-		return false;
-	}
+			
+			bool contains( char c ) const
+			{
+				const unsigned char u = c;
+				
+				return its_bits[ u >> 3 ] & (1 << (u & 7));
+			}
+	};
 	
 	const char* find_first_match( const char*           p,
 	                              const char*           end,
@@ -75,9 +170,16 @@ namespace gear
 	                              const char*           _default,
 	                              bool                  negated )
 	{
+		if ( chars[ 0 ] == 1 )
+		{
+			return find_first_match( p, end, char( chars[ 1 ] ), _default, negated );
+		}
+		
+		const char_map map( chars );
+		
 		for ( ;  p != end;  ++p )
 		{
-			if ( char_matches( *p, chars ) - negated )
+			if ( map.contains( *p ) - negated )
 			{
 				return p;
 			}
@@ -92,13 +194,20 @@ namespace gear
 	                             const char*           _default,
 	                             bool                  negated )
 	{
+		if ( chars[ 0 ] == 1 )
+		{
+			return find_last_match( p, end, char( chars[ 1 ] ), _default, negated );
+		}
+		
+		const char_map map( chars );
+		
 		const char* begin = p;
 		
 		p = end;
 		
 		while ( p != begin )
 		{
-			if ( char_matches( *--p, chars ) - negated )
+			if ( map.contains( *--p ) - negated )
 			{
 				return p;
 			}
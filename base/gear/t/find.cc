@@ -0,0 +1,178 @@
+/*
+	t/find.cc
+	---------
+*/
+
+// gear
+#include "gear/find.hh"
+
+// tap-out
+#include "tap/test.hh"
+
+
+#define PROGRAM  "find"
+
+static const unsigned n_tests = 8 + 8 + 4 + 2;
+
+
+/*
+	The word-at-a-time searches treat unaligned heads and tails separately,
+	so check every offset and length within a buffer of a few words.
+*/
+
+static char buffer[ 64 ];
+
+static const char* first_byte( const char* p, const char* end, char c, bool negated )
+{
+	for ( ;  p != end;  ++p )
+	{
+		if ( (*p == c) != negated )
+		{
+			return p;
+		}
+	}
+	
+	return 0;  // NULL
+}
+
+static const char* last_byte( const char* p, const char* end, char c, bool negated )
+{
+	while ( end != p )
+	{
+		if ( (*--end == c) != negated )
+		{
+			return end;
+		}
+	}
+	
+	return 0;  // NULL
+}
+
+static bool all_ranges_agree( char c, bool negated )
+{
+	for ( int i = 0;  i < (int) sizeof buffer;  ++i )
+	{
+		for ( int j = i;  j <= (int) sizeof buffer;  ++j )
+		{
+			const char* p   = buffer + i;
+			const char* end = buffer + j;
+			
+			using gear::find_first_match;
+			using gear::find_last_match;
+			
+			if ( find_first_match( p, end, c, 0, negated ) != first_byte( p, end, c, negated ) )
+			{
+				return false;
+			}
+			
+			if ( find_last_match( p, end, c, 0, negated ) != last_byte( p, end, c, negated ) )
+			{
+				return false;
+			}
+		}
+	}
+	
+	return true;
+}
+
+static void fill( char c )
+{
+	for ( int i = 0;  i < (int) sizeof buffer;  ++i )
+	{
+		buffer[ i ] = c;
+	}
+}
+
+static void single_byte()
+{
+	fill( 'x' );
+	
+	EXPECT( all_ranges_agree( '\n', false ) );
+	EXPECT( all_ranges_agree( 'x',  true  ) );
+	
+	buffer[ 13 ] = '\n';
+	buffer[ 40 ] = '\n';
+	
+	EXPECT( all_ranges_agree( '\n', false ) );
+	EXPECT( all_ranges_agree( 'x',  true  ) );
+	
+	// Bytes with the high bit set, and neighbors of the target value
+	
+	buffer[  7 ] = '\x80';
+	buffer[ 20 ] = '\x0B';
+	buffer[ 21 ] = '\x09';
+	buffer[ 33 ] = '\xFF';
+	
+	EXPECT( all_ranges_agree( '\n',   false ) );
+	EXPECT( all_ranges_agree( '\x80', false ) );
+	EXPECT( all_ranges_agree( '\xFF', false ) );
+	EXPECT( all_ranges_agree( '\xFF', true  ) );
+}
+
+static void char_set()
+{
+	using gear::find_first_match;
+	using gear::find_last_match;
+	using gear::find_first_nonmatch;
+	using gear::find_last_nonmatch;
+	
+	const char text[] = "foo bar\tbaz\xC2\xA0qux";
+	
+	const char* end = text + sizeof text - 1;
+	
+	const unsigned char space[] = "\x02" " \t";
+	const unsigned char high [] = "\x01" "\xA0";
+	const unsigned char none [] = "\x00";
+	const unsigned char word [] = "\x06" "abforz";
+	
+	EXPECT( find_first_match( text, end, space ) == text + 3 );
+	EXPECT( find_last_match ( text, end, space ) == text + 7 );
+	EXPECT( find_first_match( text, end, high  ) == text + 12 );
+	EXPECT( find_last_match ( text, end, high  ) == text + 12 );
+	
+	EXPECT( find_first_match( text, end, none ) == 0 );
+	EXPECT( find_first_nonmatch( text, end, none ) == text );
+	
+	EXPECT( find_first_nonmatch( text, end, word ) == text + 3 );
+	EXPECT( find_last_nonmatch ( text, end, word ) == end - 1 );
+}
+
+static void substring()
+{
+	using gear::find_first_match;
+	using gear::find_last_match;
+	
+	const char text[] = "abcabc";
+	
+	const char* end = text + sizeof text - 1;
+	
+	EXPECT( find_first_match( text, end, "bc", 2 ) == text + 1 );
+	EXPECT( find_last_match ( text, end, "bc", 2 ) == text + 4 );
+	EXPECT( find_first_match( text, end, "cb", 2 ) == 0 );
+	EXPECT( find_last_match ( text, end, "abcabcd", 7 ) == 0 );
+}
+
+static void defaults()
+{
+	using gear::find_first_match;
+	using gear::find_last_match;
+	
+	const char text[] = "abc";
+	
+	const char* end = text + sizeof text - 1;
+	
+	EXPECT( find_first_match( text, end, 'z', end ) == end );
+	EXPECT( find_last_match ( text, end, 'z', end ) == end );
+}
+
+int main( int argc, const char *const *argv )
+{
+	tap::start( PROGRAM, n_tests );
+	
+	single_byte();
+	char_set();
+	substring();
+	defaults();
+	
+	return 0;
+}
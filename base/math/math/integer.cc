@@ -660,6 +660,704 @@ namespace integer {
 		}
 	}
 	
+	/*
+		Twig arrays
+		-----------
+		
+		The algorithms below work on arrays of twigs, least significant
+		first, so that a product of two twigs (plus carries) fits in a
+		long_t, and so that they don't care about the limbs' endianness.
+		Operands are unpacked into twig arrays and the result is packed
+		back into limbs.
+	*/
+	
+	const int twig_bits = sizeof (twig_t) * 8;
+	
+	typedef unsigned long twig_count;
+	
+	static
+	void get_twigs( twig_t* t, bool le, limb_t const* x, size_t size )
+	{
+		for ( size_t i = 0;  i < size;  ++i )
+		{
+			limb_t limb = le ? x[ i ] : x[ size - 1 - i ];
+			
+			for ( unsigned k = 0;  k < twigs_per_limb;  ++k )
+			{
+				*t++ = twig_t( limb );
+				
+				// Don't shift a limb by its full width if it's only one twig.
+				limb = limb >> (twig_bits - 1) >> 1;
+			}
+		}
+	}
+	
+	static
+	void put_twigs( limb_t* x, bool le, twig_t const* t, size_t size )
+	{
+		for ( size_t i = 0;  i < size;  ++i )
+		{
+			limb_t limb = 0;
+			
+			for ( unsigned k = twigs_per_limb;  k-- > 0; )
+			{
+				limb = limb << (twig_bits - 1) << 1 | t[ k ];
+			}
+			
+			t += twigs_per_limb;
+			
+			(le ? x[ i ] : x[ size - 1 - i ]) = limb;
+		}
+	}
+	
+	class twig_buffer
+	{
+		private:
+			enum { n_local = 64 };
+			
+			twig_t* its_data;
+			twig_t  its_local[ n_local ];
+			
+			// non-copyable
+			twig_buffer           ( const twig_buffer& );
+			twig_buffer& operator=( const twig_buffer& );
+		
+		public:
+			twig_buffer( twig_count n )
+			:
+				its_data( n <= n_local ? its_local : new twig_t[ n ] )
+			{
+			}
+			
+			~twig_buffer()
+			{
+				if ( its_data != its_local )
+				{
+					delete [] its_data;
+				}
+			}
+			
+			operator twig_t*() const  { return its_data; }
+	};
+	
+	static inline
+	twig_count significant_twigs( twig_t const* t, twig_count n )
+	{
+		while ( n > 1  &&  t[ n - 1 ] == 0 )
+		{
+			--n;
+		}
+		
+		return n;
+	}
+	
+	static inline
+	void clear_twigs( twig_t* t, twig_count n )
+	{
+		while ( n-- > 0 )
+		{
+			*t++ = 0;
+		}
+	}
+	
+	static inline
+	void copy_twigs( twig_t* t, twig_t const* a, twig_count n )
+	{
+		while ( n-- > 0 )
+		{
+			*t++ = *a++;
+		}
+	}
+	
+	static
+	void add_twigs( twig_t* x, twig_count x_size, twig_t const* y, twig_count y_size )
+	{
+		// Requires that the sum fit in x_size twigs.
+		
+		y_size = significant_twigs( y, y_size );
+		
+		long_t sum = 0;
+		
+		twig_count i = 0;
+		
+		for ( ;  i < y_size;  ++i )
+		{
+			sum = (long_t) x[ i ] + y[ i ] + (sum >> twig_bits);
+			
+			x[ i ] = twig_t( sum );
+		}
+		
+		for ( ;  sum >> twig_bits  &&  i < x_size;  ++i )
+		{
+			sum = (long_t) x[ i ] + 1;
+			
+			x[ i ] = twig_t( sum );
+		}
+	}
+	
+	static
+	void subtract_twigs( twig_t* x, twig_count x_size, twig_t const* y, twig_count y_size )
+	{
+		// Requires x >= y.
+		
+		y_size = significant_twigs( y, y_size );
+		
+		bool borrowing = false;
+		
+		twig_count i = 0;
+		
+		for ( ;  i < y_size;  ++i )
+		{
+			const twig_t a = x[ i ];
+			const twig_t b = y[ i ];
+			
+			x[ i ] = a - b - borrowing;
+			
+			borrowing = borrowing ? a <= b : a < b;
+		}
+		
+		for ( ;  borrowing  &&  i < x_size;  ++i )
+		{
+			borrowing = x[ i ]-- == 0;
+		}
+	}
+	
+	/*
+		Subquadratic multiplication
+		---------------------------
+		
+		Large operands are multiplied by Karatsuba's method:  With a and b
+		split into halves a1:a0 and b1:b0, the middle term a1*b0 + a0*b1 is
+		(a1 + a0) * (b1 + b0) - a1*b1 - a0*b0, so three half-size products
+		suffice instead of four, for O(n^1.585) time overall.  Squaring needs
+		only three half-size squares.  Below the thresholds (in twigs, as
+		measured by v/bin/bignum-bench.vx), schoolbook multiplication is
+		faster.  An operand much longer than the other is multiplied in
+		pieces the length of the shorter one.
+	*/
+	
+	const twig_count karatsuba_threshold = 48;
+	const twig_count karatsuba_square_threshold = 96;
+	
+	static
+	void multiply_basecase( twig_t*        r,
+	                        twig_t const*  a, twig_count a_size,
+	                        twig_t const*  b, twig_count b_size )
+	{
+		clear_twigs( r, a_size + b_size );
+		
+		for ( twig_count i = 0;  i < a_size;  ++i )
+		{
+			if ( const long_t x = a[ i ] )
+			{
+				long_t sum = 0;
+				
+				for ( twig_count j = 0;  j < b_size;  ++j )
+				{
+					sum = x * b[ j ] + r[ i + j ] + (sum >> twig_bits);
+					
+					r[ i + j ] = twig_t( sum );
+				}
+				
+				r[ i + b_size ] = twig_t( sum >> twig_bits );
+			}
+		}
+	}
+	
+	static
+	void square_basecase( twig_t* r, twig_t const* a, twig_count n )
+	{
+		clear_twigs( r, 2 * n );
+		
+		// Sum the products a[i] * a[j] for i < j...
+		
+		for ( twig_count i = 0;  i < n;  ++i )
+		{
+			if ( const long_t x = a[ i ] )
+			{
+				long_t sum = 0;
+				
+				for ( twig_count j = i + 1;  j < n;  ++j )
+				{
+					sum = x * a[ j ] + r[ i + j ] + (sum >> twig_bits);
+					
+					r[ i + j ] = twig_t( sum );
+				}
+				
+				r[ i + n ] = twig_t( sum >> twig_bits );
+			}
+		}
+		
+		// ... double them...
+		
+		twig_t carried = 0;
+		
+		for ( twig_count i = 0;  i < 2 * n;  ++i )
+		{
+			const twig_t x = r[ i ];
+			
+			r[ i ] = x << 1 | carried;
+			
+			carried = x >> (twig_bits - 1);
+		}
+		
+		// ... and add the squares a[i] * a[i].
+		
+		long_t sum = 0;
+		
+		for ( twig_count i = 0;  i < n;  ++i )
+		{
+			sum = (long_t) a[ i ] * a[ i ] + r[ 2 * i ] + (sum >> twig_bits);
+			
+			r[ 2 * i ] = twig_t( sum );
+			
+			sum = (sum >> twig_bits) + r[ 2 * i + 1 ];
+			
+			r[ 2 * i + 1 ] = twig_t( sum );
+		}
+	}
+	
+	static
+	twig_count add_halves( twig_t*        sum,
+	                       twig_t const*  a, twig_count a_size,
+	                       twig_t const*  b, twig_count b_size )
+	{
+		if ( a_size < b_size )
+		{
+			return add_halves( sum, b, b_size, a, a_size );
+		}
+		
+		copy_twigs( sum, a, a_size );
+		
+		sum[ a_size ] = 0;
+		
+		add_twigs( sum, a_size + 1, b, b_size );
+		
+		return significant_twigs( sum, a_size + 1 );
+	}
+	
+	static
+	void combine_middle( twig_t*        r, twig_count r_size,
+	                     twig_t*        middle, twig_count middle_size,
+	                     twig_count     h )
+	{
+		// r holds the low and high products; middle holds their sum's product.
+		
+		subtract_twigs( middle, middle_size, r, 2 * h );
+		subtract_twigs( middle, middle_size, r + 2 * h, r_size - 2 * h );
+		
+		add_twigs( r + h, r_size - h, middle, middle_size );
+	}
+	
+	static
+	void multiply_twigs( twig_t*        r,
+	                     twig_t const*  a, twig_count a_size,
+	                     twig_t const*  b, twig_count b_size )
+	{
+		if ( a_size < b_size )
+		{
+			multiply_twigs( r, b, b_size, a, a_size );
+			
+			return;
+		}
+		
+		const twig_count r_size = a_size + b_size;
+		
+		if ( b_size < karatsuba_threshold )
+		{
+			multiply_basecase( r, a, a_size, b, b_size );
+		}
+		else if ( a_size >= 2 * b_size )
+		{
+			clear_twigs( r, r_size );
+			
+			twig_buffer piece( 2 * b_size );
+			
+			for ( twig_count i = 0;  i < a_size;  i += b_size )
+			{
+				const twig_count n = a_size - i < b_size ? a_size - i : b_size;
+				
+				multiply_twigs( piece, a + i, n, b, b_size );
+				
+				add_twigs( r + i, r_size - i, piece, n + b_size );
+			}
+		}
+		else
+		{
+			const twig_count h = a_size / 2;  // less than b_size
+			
+			multiply_twigs( r,         a,     h,          b,     h          );
+			multiply_twigs( r + 2 * h, a + h, a_size - h, b + h, b_size - h );
+			
+			twig_buffer a_sum( a_size - h + 1 );
+			twig_buffer b_sum( b_size     + 1 );
+			
+			const twig_count a_n = add_halves( a_sum, a, h, a + h, a_size - h );
+			const twig_count b_n = add_halves( b_sum, b, h, b + h, b_size - h );
+			
+			twig_buffer middle( a_n + b_n );
+			
+			multiply_twigs( middle, a_sum, a_n, b_sum, b_n );
+			
+			combine_middle( r, r_size, middle, a_n + b_n, h );
+		}
+	}
+	
+	static
+	void square_twigs( twig_t* r, twig_t const* a, twig_count n )
+	{
+		if ( n < karatsuba_square_threshold )
+		{
+			square_basecase( r, a, n );
+			
+			return;
+		}
+		
+		const twig_count h = n / 2;
+		
+		square_twigs( r,         a,     h     );
+		square_twigs( r + 2 * h, a + h, n - h );
+		
+		twig_buffer sum( n - h + 1 );
+		
+		const twig_count sum_n = add_halves( sum, a, h, a + h, n - h );
+		
+		twig_buffer middle( 2 * sum_n );
+		
+		square_twigs( middle, sum, sum_n );
+		
+		combine_middle( r, 2 * n, middle, 2 * sum_n, h );
+	}
+	
+	void multiply_large( bool           le,
+	                     limb_t*        x, size_t x_size,
+	                     limb_t const*  y, size_t y_size )
+	{
+		const twig_count r_size = x_size * twigs_per_limb;
+		
+		twig_buffer a( r_size );
+		twig_buffer b( y_size * twigs_per_limb );
+		twig_buffer r( r_size );
+		
+		get_twigs( a, le, x, x_size );
+		get_twigs( b, le, y, y_size );
+		
+		const twig_count a_n = significant_twigs( a, r_size );
+		const twig_count b_n = significant_twigs( b, y_size * twigs_per_limb );
+		
+		clear_twigs( r + a_n + b_n, r_size - a_n - b_n );
+		
+		multiply_twigs( r, a, a_n, b, b_n );
+		
+		put_twigs( x, le, r, x_size );
+	}
+	
+	void square( bool le, limb_t* x, size_t x_size )
+	{
+		const twig_count r_size = x_size * twigs_per_limb;
+		
+		twig_buffer a( r_size );
+		twig_buffer r( r_size );
+		
+		get_twigs( a, le, x, x_size );
+		
+		const twig_count n = significant_twigs( a, r_size );
+		
+		clear_twigs( r + 2 * n, r_size - 2 * n );
+		
+		square_twigs( r, a, n );
+		
+		put_twigs( x, le, r, x_size );
+	}
+	
+	/*
+		Division
+		--------
+		
+		This is Knuth's Algorithm D (TAOCP vol. 2, 4.3.1), with twigs as the
+		digits, so that a two-digit partial dividend fits in a long_t.
+	*/
+	
+	static
+	int leading_zeros( twig_t x )
+	{
+		const twig_t top_bit = twig_t( 1 ) << (twig_bits - 1);
+		
+		int n = 0;
+		
+		while ( ! (x & top_bit) )
+		{
+			x <<= 1;
+			++n;
+		}
+		
+		return n;
+	}
+	
+	static
+	twig_t shift_left( twig_t* t, twig_count n, int s )
+	{
+		twig_t carried = 0;
+		
+		for ( twig_count i = 0;  i < n;  ++i )
+		{
+			const twig_t x = t[ i ];
+			
+			t[ i ] = x << s | carried;
+			
+			carried = x >> (twig_bits - s);
+		}
+		
+		return carried;
+	}
+	
+	static
+	void shift_right( twig_t* t, twig_count n, int s )
+	{
+		twig_t carried = 0;
+		
+		for ( twig_count i = n;  i-- > 0; )
+		{
+			const twig_t x = t[ i ];
+			
+			t[ i ] = x >> s | carried;
+			
+			carried = x << (twig_bits - s);
+		}
+	}
+	
+	static
+	twig_t divide_by_twig( twig_t* u, twig_count m, twig_t d, twig_t* q )
+	{
+		long_t r = 0;
+		
+		for ( twig_count i = m;  i-- > 0; )
+		{
+			const long_t partial = r << twig_bits | u[ i ];
+			
+			q[ i ] = twig_t( partial / d );
+			
+			r = partial % d;
+		}
+		
+		return twig_t( r );
+	}
+	
+	static
+	void divide_twigs( twig_t* u, twig_count m, twig_t const* v, twig_count n, twig_t* q )
+	{
+		/*
+			u:  m + 1 twigs, normalized along with v, leaving the remainder
+			v:  n twigs (n > 1), normalized so that its top bit is set
+			q:  m - n + 1 twigs of quotient
+		*/
+		
+		const long_t base = long_t( 1 ) << twig_bits;
+		
+		const long_t v1 = v[ n - 1 ];
+		const long_t v2 = v[ n - 2 ];
+		
+		for ( twig_count j = m - n + 1;  j-- > 0; )
+		{
+			// Estimate the quotient digit from the top two dividend twigs.
+			
+			const long_t top = (long_t) u[ j + n ] << twig_bits | u[ j + n - 1 ];
+			
+			long_t qhat = top / v1;
+			long_t rhat = top % v1;
+			
+			while ( qhat >= base  ||  qhat * v2 > (rhat << twig_bits | u[ j + n - 2 ]) )
+			{
+				--qhat;
+				
+				rhat += v1;
+				
+				if ( rhat >= base )
+				{
+					break;
+				}
+			}
+			
+			// Multiply and subtract, carrying each borrow with the product.
+			
+			long_t carry = 0;
+			
+			for ( twig_count i = 0;  i < n;  ++i )
+			{
+				const long_t product = qhat * v[ i ] + carry;
+				
+				const twig_t a = u[ i + j ];
+				const twig_t b = twig_t( product );
+				
+				u[ i + j ] = a - b;
+				
+				carry = (product >> twig_bits) + (a < b);
+			}
+			
+			const twig_t a = u[ j + n ];
+			const twig_t b = twig_t( carry );
+			
+			u[ j + n ] = a - b;
+			
+			// If we subtracted too much (rarely), add one divisor back.
+			
+			if ( a < b )
+			{
+				--qhat;
+				
+				long_t sum = 0;
+				
+				for ( twig_count i = 0;  i < n;  ++i )
+				{
+					sum = (long_t) u[ i + j ] + v[ i ] + (sum >> twig_bits);
+					
+					u[ i + j ] = twig_t( sum );
+				}
+				
+				u[ j + n ] += twig_t( sum >> twig_bits );
+			}
+			
+			q[ j ] = twig_t( qhat );
+		}
+	}
+	
+	void divide( bool           le,
+	             limb_t*        x, size_t x_size,
+	             limb_t const*  y, size_t y_size,
+	             limb_t*        q )
+	{
+		twig_count m = x_size * twigs_per_limb;
+		twig_count n = y_size * twigs_per_limb;
+		
+		const twig_count q_size = m;
+		
+		twig_buffer buffer( (m + 1) + n + q_size );
+		
+		twig_t* u = buffer;
+		twig_t* v = u + m + 1;
+		twig_t* w = v + n;
+		
+		get_twigs( u, le, x, x_size );
+		get_twigs( v, le, y, y_size );
+		
+		for ( twig_count i = 0;  i < q_size;  ++i )
+		{
+			w[ i ] = 0;
+		}
+		
+		// The top limb is nonzero, but its upper twigs needn't be.
+		
+		while ( v[ n - 1 ] == 0 )
+		{
+			--n;
+		}
+		
+		while ( u[ m - 1 ] == 0 )
+		{
+			u[ --m ] = 0;
+		}
+		
+		if ( n == 1 )
+		{
+			u[ 0 ] = divide_by_twig( u, m, v[ 0 ], w );
+			
+			for ( twig_count i = 1;  i < m;  ++i )
+			{
+				u[ i ] = 0;
+			}
+		}
+		else
+		{
+			const int s = leading_zeros( v[ n - 1 ] );
+			
+			u[ m ] = 0;
+			
+			if ( s != 0 )
+			{
+				shift_left( v, n, s );
+				
+				u[ m ] = shift_left( u, m, s );
+			}
+			
+			divide_twigs( u, m, v, n, w );
+			
+			if ( s != 0 )
+			{
+				shift_right( u, n, s );
+			}
+			
+			for ( twig_count i = n;  i <= m;  ++i )
+			{
+				u[ i ] = 0;
+			}
+		}
+		
+		put_twigs( x, le, u, x_size );
+		put_twigs( q, le, w, x_size );
+	}
+	
+	/*
+		Short multiplication and division
+		---------------------------------
+		
+		These work on the twigs of each limb in place, with no unpacking,
+		since they're called repeatedly on the same operand.
+	*/
+	
+	twig_t multiply_add( bool le, limb_t* x, size_t x_size, twig_t m, twig_t a )
+	{
+		long_t carry = a;
+		
+		for ( size_t i = 0;  i < x_size;  ++i )
+		{
+			limb_t& limb = le ? x[ i ] : x[ x_size - 1 - i ];
+			
+			limb_t result = 0;
+			
+			for ( unsigned k = 0;  k < twigs_per_limb;  ++k )
+			{
+				const int shift = k * twig_bits;
+				
+				const long_t product = (long_t) twig_t( limb >> shift ) * m + carry;
+				
+				result |= limb_t( twig_t( product ) ) << shift;
+				
+				carry = product >> twig_bits;
+			}
+			
+			limb = result;
+		}
+		
+		return twig_t( carry );
+	}
+	
+	twig_t divide_short( bool le, limb_t* x, size_t x_size, twig_t d )
+	{
+		long_t remainder = 0;
+		
+		for ( size_t i = x_size;  i-- > 0; )
+		{
+			limb_t& limb = le ? x[ i ] : x[ x_size - 1 - i ];
+			
+			limb_t result = 0;
+			
+			for ( unsigned k = twigs_per_limb;  k-- > 0; )
+			{
+				const int shift = k * twig_bits;
+				
+				const long_t partial = remainder << twig_bits | twig_t( limb >> shift );
+				
+				result |= limb_t( twig_t( partial / d ) ) << shift;
+				
+				remainder = partial % d;
+			}
+			
+			limb = result;
+		}
+		
+		return twig_t( remainder );
+	}
+	
 	/*
 		Bit shifts
 		----------
@@ -65,6 +65,14 @@
 	  * subtract:     Subtracts the second operand from the first one.  This
 	                  is strictly a cancellation function, requiring x >= y.
 	  * multiply:     Multiplies the first operand by the second one.
+	  * square:       Multiplies the operand by itself.
+	  * divide:       Divides the first operand by the second one, leaving the
+	                  remainder in the first and storing the quotient in a
+	                  third operand the size of the first.
+	  * multiply_add: Multiplies the operand by a twig and adds another one,
+	                  returning the carry out of the most significant limb.
+	  * divide_short: Divides the operand by a nonzero twig, returning the
+	                  remainder.
 	  * shift_right:  Shifts the operand to the right by one bit.  The most
 	                  significant one bit is replaced by a zero; the least
 	                  significant bit is discarded.
@@ -76,6 +84,8 @@
 	    multiply, the sum of the two operand sizes will be sufficient.  (Since
 	    subtraction is strictly a diminishing operation, the result will never
 	    exceed the left operand.)
+	  * The divisor's most significant limb must be nonzero, and the divisor
+	    must not be larger than the dividend.
 */
 
 
@@ -299,12 +309,28 @@ namespace integer {
 	void multiply_le( limb_t*       x_high, size_t x_size,
 	                  limb_t const* y_high, size_t y_size );
 	
+	/*
+		multiply_large() unpacks its operands into twig arrays and uses
+		Karatsuba multiplication, which pays for the unpacking once the
+		second operand reaches multiply_large_threshold limbs.
+	*/
+	
+	const size_t multiply_large_threshold = 4;
+	
+	void multiply_large( bool           is_little_endian,
+	                     limb_t*        x, size_t x_size,
+	                     limb_t const*  y, size_t y_size );
+	
 	inline
 	void multiply( bool           is_little_endian,
 	               limb_t*        x, size_t x_size,
 	               limb_t const*  y, size_t y_size )
 	{
-		if ( is_little_endian )
+		if ( y_size >= multiply_large_threshold )
+		{
+			multiply_large( is_little_endian, x, x_size, y, y_size );
+		}
+		else if ( is_little_endian )
 		{
 			x += x_size;
 			y += y_size;
@@ -317,6 +343,34 @@ namespace integer {
 		}
 	}
 	
+	// Squares x in place.  As with multiply(), x has room for the result.
+	
+	void square( bool is_little_endian, limb_t* x, size_t x_size );
+	
+	/*
+		Division
+		--------
+	*/
+	
+	void divide( bool           is_little_endian,
+	             limb_t*        x, size_t x_size,
+	             limb_t const*  y, size_t y_size,
+	             limb_t*        q );
+	
+	/*
+		Short multiplication and division, by a single twig.  These are the
+		inner loops of radix conversion (e.g. in chunks of 10^9 digits).
+	*/
+	
+	twig_t multiply_add( bool     is_little_endian,
+	                     limb_t*  x, size_t x_size,
+	                     twig_t   m,
+	                     twig_t   a );
+	
+	twig_t divide_short( bool     is_little_endian,
+	                     limb_t*  x, size_t x_size,
+	                     twig_t   d );
+	
 	/*
 		Bit shifts
 		----------
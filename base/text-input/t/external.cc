@@ -0,0 +1,167 @@
+/*
+	t/external.cc
+	-------------
+*/
+
+// iota
+#include "iota/strings.hh"
+
+// text-input
+#include "text_input/feed.hh"
+#include "text_input/get_line_from_feed.hh"
+
+// tap-out
+#include "tap/test.hh"
+
+
+static const unsigned n_tests = 13 + 6 + 4;
+
+
+#ifndef NULL
+#define NULL  0
+#endif
+
+
+static const char text[] = "foo\n"
+                           "bar\r"
+                           "baz\r\n"
+                           "qux\r\n"
+                           "\n"
+                           "zee";
+
+static bool is_view( const plus::string* s, const char* begin, unsigned n )
+{
+	return s  &&  s->data() == begin  &&  s->size() == n;
+}
+
+static void views()
+{
+	text_input::feed feed;
+	
+	feed.accept_external_input( text, sizeof text - 1 );
+	
+	const plus::string* line;
+	
+	line = feed.get_line();
+	
+	EXPECT( line  &&  *line == "foo\n" );
+	EXPECT( is_view( line, text, 4 ) );  // includes the LF
+	
+	line = feed.get_line();
+	
+	EXPECT( line  &&  *line == "bar\n" );
+	EXPECT( line  &&  line->data() != text + 4 );  // CR becomes LF:  copied
+	
+	line = feed.get_line_bare();
+	
+	EXPECT( line  &&  *line == "baz" );
+	EXPECT( is_view( line, text + 8, 3 ) );
+	
+	line = feed.get_line();
+	
+	EXPECT( line  &&  *line == "qux\n" );
+	EXPECT( line  &&  line->data() != text + 13 );  // CRLF becomes LF:  copied
+	
+	line = feed.get_line_bare();
+	
+	EXPECT( line  &&  *line == "" );
+	
+	EXPECT( feed.get_line() == NULL );
+	
+	const plus::string& fragment = feed.get_fragment_ref();
+	
+	EXPECT( fragment == "zee" );
+	
+	EXPECT( feed.get_fragment() == NULL );
+	
+	// Switching back to the internal buffer
+	
+	feed.accept_input( STR_LEN( "zig\n" ) );
+	
+	line = feed.get_line();
+	
+	EXPECT( line  &&  *line == "zig\n" );
+}
+
+static void spanning()
+{
+	text_input::feed feed;
+	
+	const char a[] = "foo\r";
+	const char b[] = "\nbar";
+	const char c[] = "baz\nqux\n";
+	
+	feed.accept_external_input( a, sizeof a - 1 );
+	
+	const plus::string* line = feed.get_line_bare();
+	
+	EXPECT( is_view( line, a, 3 ) );
+	
+	feed.accept_external_input( b, sizeof b - 1 );  // LF of CRLF is skipped
+	
+	EXPECT( feed.get_line_bare() == NULL );
+	
+	feed.accept_input( STR_LEN( "-" ) );
+	
+	EXPECT( feed.get_line_bare() == NULL );
+	
+	feed.accept_external_input( c, sizeof c - 1 );
+	
+	line = feed.get_line();
+	
+	EXPECT( line  &&  *line == "bar-baz\n" );  // spans three inputs
+	
+	line = get_line_bare_from_feed( feed );
+	
+	EXPECT( is_view( line, c + 4, 3 ) );
+	
+	EXPECT( get_line_bare_from_feed( feed ) == NULL );
+}
+
+static void occupied()
+{
+	text_input::feed feed;
+	
+	feed.accept_external_input( STR_LEN( "foo\nbar" ) );
+	
+	bool buffer_occupied = false;
+	
+	try
+	{
+		feed.buffer();
+	}
+	catch ( const text_input::feed::buffer_occupied& )
+	{
+		buffer_occupied = true;
+	}
+	
+	EXPECT( buffer_occupied );
+	
+	buffer_occupied = false;
+	
+	try
+	{
+		feed.accept_external_input( STR_LEN( "\n" ) );
+	}
+	catch ( const text_input::feed::buffer_occupied& )
+	{
+		buffer_occupied = true;
+	}
+	
+	EXPECT( buffer_occupied );
+	
+	EXPECT( feed.get_line_bare() != NULL );
+	
+	EXPECT( feed.get_line_bare() == NULL );
+}
+
+int main( int argc, const char *const *argv )
+{
+	tap::start( "external", n_tests );
+	
+	views();
+	spanning();
+	occupied();
+	
+	return 0;
+}
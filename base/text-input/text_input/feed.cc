@@ -20,7 +20,7 @@ namespace text_input
 	
 	void feed::advance_CRLF()
 	{
-		if ( its_last_end_was_CR  &&  its_mark < its_data_length  &&  its_buffer[ its_mark ] == '\n' )
+		if ( its_last_end_was_CR  &&  its_mark < its_data_length  &&  its_data[ its_mark ] == '\n' )
 		{
 			++its_mark;
 			
@@ -28,10 +28,10 @@ namespace text_input
 		}
 	}
 	
-	const plus::string* feed::get_line_bare()
+	const plus::string* feed::get_next_line( bool with_newline )
 	{
-		const char* begin = &its_buffer[ its_mark        ];
-		const char* end   = &its_buffer[ its_data_length ];
+		const char* begin = &its_data[ its_mark        ];
+		const char* end   = &its_data[ its_data_length ];
 		
 		ASSERT( begin <= end );
 		
@@ -39,60 +39,85 @@ namespace text_input
 		
 		const char* eol = gear::find_first_match( begin, end, newlines );
 		
-		if ( eol != NULL )
+		if ( eol == NULL )
 		{
-			its_last_line.assign( begin, eol );
+			its_next_line.append( begin, end );
 			
-			its_last_end_was_CR = *eol++ == '\r';
+			its_mark = its_data_length;
 			
-			its_mark += eol - begin;
+			return NULL;
+		}
+		
+		its_last_end_was_CR = *eol == '\r';
+		
+		its_mark += eol + 1 - begin;
+		
+		advance_CRLF();
+		
+		const size_type length = eol - begin;
+		
+		if ( ! its_next_line.empty() )
+		{
+			// The line began in a previous input.
 			
-			advance_CRLF();
+			its_next_line.append( begin, length );
 			
-			if ( !its_next_line.empty() )
+			if ( with_newline )
 			{
-				its_next_line += its_last_line;
-				
-				its_last_line = its_next_line.move();
-				
-				its_next_line.clear();
+				its_next_line += '\n';
 			}
 			
-			return &its_last_line;
+			its_last_line = its_next_line.move();
+			
+			its_next_line.clear();
 		}
-		
-		its_next_line.append( begin, end );
-		
-		its_mark = its_data_length;
-		
-		return NULL;
-	}
-	
-	const plus::string* feed::get_line()
-	{
-		if ( const plus::string* line = get_line_bare() )
+		else if ( is_external()  &&  (*eol == '\n'  ||  ! with_newline) )
 		{
-			plus::var_string temp = its_last_line.move();
+			// Return a view, including the LF if it's wanted.
 			
-			temp += '\n';
+			its_last_line.assign( begin, length + with_newline, plus::delete_never );
+		}
+		else
+		{
+			char* p = its_last_line.reset( length + with_newline );
 			
-			its_last_line = temp.move();
+			memcpy( p, begin, length );
 			
-			return &its_last_line;
+			if ( with_newline )
+			{
+				p[ length ] = '\n';
+			}
 		}
 		
-		return NULL;
+		return &its_last_line;
+	}
+	
+	const plus::string* feed::get_line_bare()
+	{
+		return get_next_line( false );
+	}
+	
+	const plus::string* feed::get_line()
+	{
+		return get_next_line( true );
 	}
 	
 	const plus::string& feed::get_fragment_ref()
 	{
-		const char* begin = &its_buffer[ its_mark        ];
-		const char* end   = &its_buffer[ its_data_length ];
-		
-		its_next_line.append( begin, end );
+		const char* begin = &its_data[ its_mark        ];
+		const char* end   = &its_data[ its_data_length ];
 		
 		its_mark = its_data_length;
 		
+		if ( is_external()  &&  its_next_line.empty() )
+		{
+			its_last_line.assign( begin, end - begin, plus::delete_never );
+			
+			return its_last_line;
+		}
+		
+		its_next_line.append( begin, end );
+		
 		its_last_line = its_next_line.move();
 		
 		its_next_line.clear();
@@ -125,6 +150,7 @@ namespace text_input
 		
 		ASSERT( its_mark == its_data_length );
 		
+		its_data        = its_buffer;
 		its_data_length = length;
 		its_mark        = 0;
 		
@@ -143,4 +169,18 @@ namespace text_input
 		accept_input( length );
 	}
 	
+	void feed::accept_external_input( const char* data, size_type length )
+	{
+		if ( its_mark != its_data_length )
+		{
+			throw buffer_occupied();
+		}
+		
+		its_data        = data;
+		its_data_length = length;
+		its_mark        = 0;
+		
+		advance_CRLF();
+	}
+	
 }
@@ -26,6 +26,8 @@ namespace text_input
 		private:
 			char its_buffer[ buffer_length ];
 			
+			const char* its_data;
+			
 			size_type its_data_length;
 			size_type its_mark;
 			
@@ -37,10 +39,15 @@ namespace text_input
 		
 		private:
 			void advance_CRLF();
+			
+			const plus::string* get_next_line( bool with_newline );
+			
+			bool is_external() const  { return its_data != its_buffer; }
 		
 		public:
 			feed()
 			:
+				its_data( its_buffer ),
 				its_data_length(),
 				its_mark(),
 				its_last_end_was_CR()
@@ -59,6 +66,17 @@ namespace text_input
 			void accept_input( size_type length );
 			
 			void accept_input( const char* buffer, size_type length );
+			
+			/*
+				External input is read in place, with no size limit -- e.g.
+				an entire mmap()ed file.  Lines that lie wholly within it
+				are returned as views into it (so the data must outlive any
+				copies of them).  Only a partial line at the end, which may
+				continue in the next input, is copied.  Once it's consumed,
+				buffer() may be used again.
+			*/
+			
+			void accept_external_input( const char* data, size_type length );
 	};
 	
 }
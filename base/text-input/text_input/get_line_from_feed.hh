@@ -13,6 +13,19 @@
 namespace text_input
 {
 	
+	inline
+	const plus::string* get_line_bare_from_feed( text_input::feed& feed )
+	{
+		// All input has been fed (e.g. as one external input).
+		
+		if ( const plus::string* result = feed.get_line_bare() )
+		{
+			return result;
+		}
+		
+		return feed.get_fragment();
+	}
+	
 	template < class Reader >
 	const plus::string* get_line_bare_from_feed( text_input::feed&  feed,
 	                                             Reader             read )
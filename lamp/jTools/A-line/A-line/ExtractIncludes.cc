@@ -17,6 +17,8 @@
 
 // poseven
 #include "poseven/extras/fd_reader.hh"
+#include "poseven/functions/fstat.hh"
+#include "poseven/functions/mmap.hh"
 #include "poseven/functions/open.hh"
 #include "poseven/functions/write.hh"
 
@@ -71,7 +73,9 @@ namespace tool
 					
 					std::vector< plus::string >& v( c == '"' ? includes.user : includes.system );
 					
-					v.push_back( line.substr( pos, end - pos ) );
+					// Copy, since line may be a view of a mapped file.
+					
+					v.push_back( plus::string( line.data() + pos, end - pos ) );
 				}
 				catch ( const BadIncludeDirective& )
 				{
@@ -90,6 +94,27 @@ namespace tool
 		
 		n::owned< p7::fd_t > fd = p7::open( pathname, p7::o_rdonly );
 		
+		const struct stat sb = p7::fstat( fd );
+		
+		if ( S_ISREG( sb.st_mode )  &&  sb.st_size > 0 )
+		{
+			// Map the file and scan its lines in place.
+			
+			n::owned< p7::mmap_t > m = p7::mmap( sb.st_size,
+			                                     p7::prot_read,
+			                                     p7::map_private,
+			                                     fd );
+			
+			feed.accept_external_input( (const char*) m.get().addr, sb.st_size );
+			
+			while ( const plus::string* s = get_line_bare_from_feed( feed ) )
+			{
+				ExtractInclude( *s, result );
+			}
+			
+			return;
+		}
+		
 		p7::fd_reader reader( fd );
 		
 		while ( const plus::string* s = get_line_bare_from_feed( feed, reader ) )
@@ -9,6 +9,14 @@
 namespace quickdraw
 {
 	
+	static inline
+	bool fits_in_32_bits( long long x )
+	{
+		const long long max = 0x7FFFFFFF;
+		
+		return x <= max  &&  x >= -max - 1;
+	}
+	
 	long fix_mul( long a, long b )
 	{
 		const unsigned long long product = (long long) a * b;
@@ -22,7 +30,7 @@ namespace quickdraw
 		
 		rounded_product >>= 16;
 		
-		if ( rounded_product != (long) rounded_product )
+		if ( ! fits_in_32_bits( rounded_product ) )
 		{
 			const bool negative = (a < 0) != (b < 0);
 			
@@ -60,4 +68,27 @@ namespace quickdraw
 		return quotient + 2 * remainder / denom;
 	}
 	
+	long fix_div( long x, long y )
+	{
+		if ( y == 0 )
+		{
+			return x < 0 ? 0x80000000 : 0x7FFFFFFF;
+		}
+		
+		// Round as fix_ratio() does.
+		
+		const long long n = (long long) x * 0x10000;
+		
+		const long long quotient = n / y + 2 * (n % y) / y;
+		
+		if ( ! fits_in_32_bits( quotient ) )
+		{
+			const bool negative = (x < 0) != (y < 0);
+			
+			return negative ? 0x80000000 : 0x7FFFFFFF;
+		}
+		
+		return quotient;
+	}
+	
 }
@@ -9,23 +9,26 @@
 namespace quickdraw
 {
 	
+	/*
+		These give the 68K results (32-bit Fixed, 16-bit short) even where
+		long is wider, so host code (e.g. v68k's native traps) can use them.
+	*/
+	
 	long fix_mul( long a, long b );
 	
 	long fix_ratio( short numer, short denom );
 	
+	long fix_div( long x, long y );
+	
 	inline
 	short fix_round( long x )
 	{
-		const unsigned long unrounded = x;
-		
-		const long rounded = unrounded + 0x8000;
-		
-		if ( rounded < 0  &&  x >= 0 )
+		if ( x >= 0x7FFF8000 )
 		{
 			return 0x7FFF;
 		}
 		
-		return rounded >> 16;
+		return (x + 0x8000) >> 16;
 	}
 	
 }
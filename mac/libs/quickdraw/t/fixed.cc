@@ -0,0 +1,88 @@
+/*
+	fixed.cc
+	--------
+*/
+
+// quickdraw
+#include "qd/fixed.hh"
+
+// tap-out
+#include "tap/test.hh"
+
+
+#pragma exceptions off
+
+
+static const unsigned n_tests = 6 + 4 + 8 + 4;
+
+
+using quickdraw::fix_mul;
+using quickdraw::fix_ratio;
+using quickdraw::fix_div;
+using quickdraw::fix_round;
+
+
+static inline
+unsigned long fixed_bits( long x )
+{
+	// Compare results as 68K longs, whatever the host's long is.
+	
+	return x & 0xFFFFFFFFul;
+}
+
+static void mul()
+{
+	EXPECT_EQ( fix_mul( 3 << 16, 0x28000 ), 0x78000 );
+	
+	// Ties round toward +infinity.
+	
+	EXPECT_EQ( fix_mul(  0x8000, 1 ), 1 );
+	EXPECT_EQ( fix_mul( -0x8000, 1 ), 0 );
+	EXPECT_EQ( fix_mul( -0x18000, 1 ), -1 );
+	
+	EXPECT_EQ( fixed_bits( fix_mul( 0x7FFFFFFF,  0x7FFFFFFF ) ), 0x7FFFFFFFul );
+	EXPECT_EQ( fixed_bits( fix_mul( 0x7FFFFFFF, -0x7FFFFFFF ) ), 0x80000000ul );
+}
+
+static void ratio()
+{
+	EXPECT_EQ( fix_ratio( 1, 3 ), 0x5555 );
+	EXPECT_EQ( fix_ratio( 2, 3 ), 0xAAAB );
+	EXPECT_EQ( fix_ratio( -2, 3 ), -0xAAAB );
+	
+	EXPECT_EQ( fixed_bits( fix_ratio( -1, 0 ) ), 0x80000000ul );
+}
+
+static void div()
+{
+	EXPECT_EQ( fix_div( 1 << 16, 3 << 16 ), 0x5555 );
+	EXPECT_EQ( fix_div( 2 << 16, 3 << 16 ), 0xAAAB );
+	EXPECT_EQ( fix_div( 5 << 16, -0x20000 ), -0x28000 );
+	EXPECT_EQ( fix_div( -0x50000, 2 << 16 ), -0x28000 );
+	EXPECT_EQ( fix_div( -0x10000, 3 << 16 ), -0x5555 );
+	EXPECT_EQ( fix_div( -0x20000, 3 << 16 ), -0xAAAB );
+	
+	EXPECT_EQ( fixed_bits( fix_div( 0x7FFF0000, 0x8000 ) ), 0x7FFFFFFFul );
+	EXPECT_EQ( fixed_bits( fix_div( -1, 0 ) ), 0x80000000ul );
+}
+
+static void round()
+{
+	EXPECT_EQ( fix_round( 0x18000 ), 2 );
+	EXPECT_EQ( fix_round( -0x8000 ), 0 );
+	EXPECT_EQ( fix_round( -0x18000 ), -1 );
+	
+	EXPECT_EQ( fix_round( 0x7FFFFFFF ), 0x7FFF );
+}
+
+int main( int argc, const char *const *argv )
+{
+	tap::start( "fixed", n_tests );
+	
+	mul();
+	ratio();
+	div();
+	round();
+	
+	return 0;
+}
@@ -22,3 +22,23 @@ $ vc 'var t = str^[]; t <-- (); t'
 
 $ vc 'int^[] map {_}'
 1 >= '[]'
+
+%
+
+$ vc 'var t = str^[]; for i in 0 -> 20 do {t[str i] = i}; t["13"]'
+1 >= 13
+
+%
+
+$ vc 'var t = str^[]; for i in 0 -> 20 do {t[str i] = i}; var u = t; u["13"] = 0; t["13"], u["13"]'
+1 >= '(13, 0)'
+
+%
+
+$ vc 'var t = int^[]; for i in 0 -> 12 do {t <-- i => -i}; t[11] = 0; t[12] = 12; t[11], t[12], t.length'
+1 >= '(0, 12, 13)'
+
+%
+
+$ vc 'var t = str^[]; for i in 0 -> 10 do {t[str i] = i}; var r = tail(*t); t["5"] = 99; t["10"] = 10; r'
+1 >= '(("1" => 1), ("2" => 2), ("3" => 3), ("4" => 4), ("5" => 5), ("6" => 6), ("7" => 7), ("8" => 8), ("9" => 9))'
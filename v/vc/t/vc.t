@@ -190,6 +190,76 @@ $ vc 2^64
 
 %
 
+$ vc 'str (10^599 - 1) == "9" * 599, str 10^598 == str( "1", "0" * 598 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 599) == 10^599 - 1, int str( "1", "0" * 598 ) == 10^598'
+1 >= '(true, true)'
+
+%
+
+$ vc 'str (10^600 - 1) == "9" * 600, str 10^599 == str( "1", "0" * 599 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 600) == 10^600 - 1, int str( "1", "0" * 599 ) == 10^599'
+1 >= '(true, true)'
+
+%
+
+$ vc 'str (10^601 - 1) == "9" * 601, str 10^600 == str( "1", "0" * 600 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 601) == 10^601 - 1, int str( "1", "0" * 600 ) == 10^600'
+1 >= '(true, true)'
+
+%
+
+$ vc 'str (10^1999 - 1) == "9" * 1999, str 10^1998 == str( "1", "0" * 1998 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 1999) == 10^1999 - 1, int str( "1", "0" * 1998 ) == 10^1998'
+1 >= '(true, true)'
+
+%
+
+$ vc 'str (10^2000 - 1) == "9" * 2000, str 10^1999 == str( "1", "0" * 1999 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 2000) == 10^2000 - 1, int str( "1", "0" * 1999 ) == 10^1999'
+1 >= '(true, true)'
+
+%
+
+$ vc 'str (10^2001 - 1) == "9" * 2001, str 10^2000 == str( "1", "0" * 2000 )'
+1 >= '(true, true)'
+
+%
+
+$ vc 'int ("9" * 2001) == 10^2001 - 1, int str( "1", "0" * 2000 ) == 10^2000'
+1 >= '(true, true)'
+
+%
+
+$ vc 'const s = str( "1234567890" * 450 ); str int s == s'
+1 >= true
+
+%
+
+$ vc 'const x = -3^5000; const s = str x; int s == x, s.length, s[ 0 -> 13 ], s[ s.length - 12 -> s.length ]'
+1 >= '(true, 2387, "-403899762978", "998276100001")'
+
+%
+
 $ vc '9876543210987654321098765432109876543210 div 7'
 1 >= 1410934744426807760156966490301410934744
 
@@ -200,6 +270,86 @@ $ vc '9876543210987654321098765432109876543210 % 7'
 
 %
 
+$ vc '0x7fffffff800000000000000000000000 div 0x800000000000000000000001'
+1 >= 4294967294
+
+%
+
+$ vc '0x7fffffff800000000000000000000000 % 0x800000000000000000000001'
+1 >= 39614081257132168792477007874
+
+%
+
+$ vc -- '-0x7fffffff800000000000000000000000 div 0x800000000000000000000001'
+1 >= -4294967294
+
+%
+
+$ vc -- '-0x7fffffff800000000000000000000000 % 0x800000000000000000000001'
+1 >= -39614081257132168792477007874
+
+%
+
+$ vc '0x7fffffff800000000000000000000000 div -0x800000000000000000000001'
+1 >= -4294967294
+
+%
+
+$ vc '0x7fffffff800000000000000000000000 % -0x800000000000000000000001'
+1 >= 39614081257132168792477007874
+
+%
+
+$ vc -- '-0x7fffffff800000000000000000000000 div -0x800000000000000000000001'
+1 >= 4294967294
+
+%
+
+$ vc -- '-0x7fffffff800000000000000000000000 % -0x800000000000000000000001'
+1 >= -39614081257132168792477007874
+
+%
+
+$ vc '0x800000000000000000000003 div 0x200000000000000000000001'
+1 >= 3
+
+%
+
+$ vc '0x800000000000000000000003 % 0x200000000000000000000001'
+1 >= 9903520314283042199192993792
+
+%
+
+$ vc '3^150 div 7^40'
+1 >= 58112105022393747904914796275992515767
+
+%
+
+$ vc '3^150 % 7^40'
+1 >= 1063019302470221748900469164424482
+
+%
+
+$ vc -- '-3^150 div 7^40'
+1 >= -58112105022393747904914796275992515767
+
+%
+
+$ vc -- '-3^150 % 7^40'
+1 >= -1063019302470221748900469164424482
+
+%
+
+$ vc '3^150 div -7^40'
+1 >= -58112105022393747904914796275992515767
+
+%
+
+$ vc '3^150 % -7^40'
+1 >= 1063019302470221748900469164424482
+
+%
+
 $ vc true
 1 >= true
 
@@ -983,6 +1133,36 @@ $ vc 'var x = 2; x *= 3; x'
 
 %
 
+$ vc 'const a = 3^940; const b = 5^640 + 1; const p = a * b; p % 1000000007, p div b == a'
+1 >= '(958617803, true)'
+
+%
+
+$ vc 'const a = 3^960; const b = 5^661 + 1; const p = a * b; p % 1000000007, p div b == a'
+1 >= '(991139115, true)'
+
+%
+
+$ vc 'const a = 3^980; const b = 5^670 + 1; const p = a * b; p % 1000000007, p div b == a'
+1 >= '(403087538, true)'
+
+%
+
+$ vc 'const a = 3^3000; const b = 5^661 + 1; const p = a * b; p % 1000000007, p div a == b'
+1 >= '(425104604, true)'
+
+%
+
+$ vc 'var x = 3^1900; x *= x; x % 1000000007, x div 3^1900 == 3^1900'
+1 >= '(784194253, true)'
+
+%
+
+$ vc 'var x = 3^1920; x *= x; x % 1000000007, x div 3^1920 == 3^1920'
+1 >= '(515622589, true)'
+
+%
+
 $ vc 'var x = 7; x /:= 3; x'
 1 >= 2
 
@@ -2453,6 +2633,26 @@ $ vc 'assert (1 == 2) == (3 == 4)'
 
 %
 
+$ vc 'def f { assert (return 2); 1 }; f()'
+1 >= 2
+
+%
+
+$ vc 'var t = str^[]; for k in ["a", "b", "c"] do {t[if k == "b" then {break} else {k}] = 2}; t'
+1 >= '(string^["a" => 2])'
+
+%
+
+$ vc 'def f { var a = [1, 2]; a[return 7] = 3; 0 }; f()'
+1 >= 7
+
+%
+
+$ vc 'def f { var a = [1, 2]; ++a[return 7]; 0 }; f()'
+1 >= 7
+
+%
+
 $ vc 'try {throw "foo"} catch {"bar"}'
 1 >= '"bar"'
 
@@ -2638,6 +2838,26 @@ $ vc 'const f = lambda {while true do {return 1; break;}; return 2; 3 }; f()'
 
 %
 
+$ vc 'const f = lambda {for x in 1 -> 10 do {if x == 4 then {return x}}; 0}; f()'
+1 >= '4'
+
+%
+
+$ vc 'const f = lambda {var y = if true then {return 7} else {2}; y + 1}; f()'
+1 >= '7'
+
+%
+
+$ vc 'const f = lambda {[1, 2, 3] map {return 5}}; f()'
+1 >= '5'
+
+%
+
+$ vc 'var x = 0; while true do {x = [1, 2] map {break}; x = 9}; x'
+1 >= '0'
+
+%
+
 $ vc 'const f = lambda {_}; f("round")'
 1 >= '"round"'
 
@@ -2773,6 +2993,21 @@ $ vc 'var x = [1, 2]; x <-- (); x'
 
 %
 
+$ vc 'var a = []; for i in 0 -> 20 do {a <-- i}; var b = a; b[15] = 0; a[15], b[15], a.length'
+1 >= '(15, 0, 20)'
+
+%
+
+$ vc 'var a = []; for i in 0 -> 20 do {a <-- i}; var r = [tail(*a)]; a[12] = 0; r[11], a[12]'
+1 >= '(12, 0)'
+
+%
+
+$ vc 'var a = [1, 2, 3]; var b = a; a[2] = 0; a, b'
+1 >= '([1, 2, 0], [1, 2, 3])'
+
+%
+
 $ vc 'var x = []; x <-- 3, 4; x'
 1 >= '[3, 4]'
 
@@ -3098,6 +3333,11 @@ $ vc 'var x = str^[foo: 1, bar: 2]; x[ "foo" ] = x; x'
 
 %
 
+$ vc 'var a = 1; var b = 2; var c = 3; var d = 4; var e = 5; var f = 6; var g = 7; var h = 8; var i = 9; var j = 10; for x in 1 -> 3 do {j += x * i}; for y in 1 -> 2 do {j += y}; [a, b, h, i, j]'
+1 >= '[1, 2, 8, 9, 38]'
+
+%
+
 $ vc 'var a = []; for i in 1 .. 3 do { a <-- i }; a'
 1 >= '[1, 2, 3]'
 
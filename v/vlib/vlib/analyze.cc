@@ -202,24 +202,27 @@ namespace vlib
 	{
 		private:
 			lexical_scope_box its_scope;
+			lexical_scope*    its_top_scope;
 			
 			bool     it_is_a_module;
 			unsigned its_export_count;
 			
-			Variable its_exports;
+			Value its_exports;
 		
 		private:
 			Value enscope( const Value& block ) const;
 			
+			const Value& declare_exports();
+			
 			void visit( Value& syntree, const source_spec& source );
 		
 		public:
 			Analyzer( lexical_scope* globals )
 			:
 				its_scope( globals ),
+				its_top_scope( its_scope.get() ),
 				it_is_a_module(),
-				its_export_count(),
-				its_exports( "__export__" )
+				its_export_count()
 			{
 			}
 			
@@ -231,6 +234,23 @@ namespace vlib
 		return Value( its_scope->symbols(), Op_scope, block );
 	}
 	
+	/*
+		The exports are collected in a top-level variable, so that each run
+		of the tree (see execute_afresh()) collects its own.  Its name isn't
+		an identifier, so scripts can neither see it nor collide with it.
+	*/
+	
+	static const char exports_name[] = "(export)";
+	
+	const Value& Analyzer::declare_exports()
+	{
+		const Value& symbol = its_top_scope->declare( exports_name, Symbol_var );
+		
+		its_exports = its_top_scope->resolve( exports_name );
+		
+		return symbol;
+	}
+	
 	void Analyzer::visit( Value& v, const source_spec& source )
 	{
 		if ( Expr* expr = v.expr() )
@@ -251,9 +271,9 @@ namespace vlib
 				
 				it_is_a_module = true;
 				
-				Value exports( Op_export, empty_array );
+				const Value& symbol = declare_exports();
 				
-				its_exports.sym()->deref() = exports;
+				symbol.sym()->deref() = Value( Op_export, empty_array );
 				
 				return;
 			}
@@ -266,7 +286,12 @@ namespace vlib
 				
 				++its_export_count;
 				
-				expr->left = its_exports;
+				if ( ! its_exports )
+				{
+					declare_exports();
+				}
+				
+				expr->left = its_scope->resolve( exports_name );
 			}
 			else if ( op == Op_block )
 			{
@@ -0,0 +1,383 @@
+/*
+	array-index.cc
+	--------------
+*/
+
+#include "vlib/array-index.hh"
+
+// bignum
+#include "bignum/integer.hh"
+
+// vlib
+#include "vlib/equal.hh"
+#include "vlib/string-utils.hh"
+#include "vlib/throw.hh"
+#include "vlib/types/boolean.hh"
+#include "vlib/types/byte.hh"
+#include "vlib/types/mb32.hh"
+
+
+namespace vlib
+{
+	
+	unsigned long hash_key( const Value& key )
+	{
+		unsigned long hash;
+		
+		switch ( key.type() )
+		{
+			case Value_boolean:
+				hash = !!(const Boolean&) key;
+				break;
+			
+			case Value_byte:
+				hash = ((const Byte&) key).get();
+				break;
+			
+			case Value_mb32:
+				hash = ((const MB32&) key).get();
+				break;
+			
+			case Value_number:
+				{
+					// Equal integers have equal low-order words and signs.
+					
+					const bignum::integer& i = key.number();
+					
+					hash = i.clipped() ^ -(unsigned long) i.is_negative();
+				}
+				
+				break;
+			
+			case Value_string:
+			case Value_packed:
+				hash = hash_bytes( key.string() );
+				break;
+			
+			default:
+				THROW( "unsupported key type" );
+		}
+		
+		return (hash ^ hash >> 16) * 31 + key.type();
+	}
+	
+	bool equal_keys( const Value& a, const Value& b )
+	{
+		if ( a.type() != b.type() )
+		{
+			return false;
+		}
+		
+		switch ( a.type() )
+		{
+			case Value_boolean:
+			case Value_byte:
+			case Value_number:
+			case Value_mb32:
+			case Value_packed:
+				break;
+			
+			case Value_string:
+				return a.string() == b.string();
+			
+			default:
+				THROW( "unsupported key type" );
+		}
+		
+		return equal( a, b );
+	}
+	
+	static inline
+	const Value& slot_key( const Value* slot )
+	{
+		return slot->expr()->left;
+	}
+	
+	array_index::array_index( bool exclusive )
+	:
+		its_key_count(),
+		it_is_exclusive( exclusive ),
+		its_predecessor()
+	{
+	}
+	
+	array_index::~array_index()
+	{
+		delete its_predecessor;
+	}
+	
+	void array_index::grow()
+	{
+		std::vector< entry > entries( its_entries.size() * 2 );
+		
+		const unsigned long mask = entries.size() - 1;
+		
+		typedef std::vector< entry >::const_iterator Iter;
+		
+		for ( Iter it = its_entries.begin();  it != its_entries.end();  ++it )
+		{
+			if ( it->position )
+			{
+				unsigned long i = it->hash & mask;
+				
+				while ( entries[ i ].position )
+				{
+					i = (i + 1) & mask;
+				}
+				
+				entries[ i ] = *it;
+			}
+		}
+		
+		its_entries.swap( entries );
+	}
+	
+	/*
+		Entries hold positions plus one, so that zero marks an empty entry.
+	*/
+	
+	void array_index::insert_key( unsigned long position )
+	{
+		if ( (its_key_count + 1) * 4 > its_entries.size() * 3 )
+		{
+			grow();
+		}
+		
+		const Value& key = slot_key( its_slots[ position ] );
+		
+		const unsigned long hash = hash_key( key );
+		const unsigned long mask = its_entries.size() - 1;
+		
+		unsigned long i = hash & mask;
+		
+		while ( unsigned long other = its_entries[ i ].position )
+		{
+			if ( its_entries[ i ].hash == hash )
+			{
+				if ( equal_keys( key, slot_key( its_slots[ other - 1 ] ) ) )
+				{
+					return;  // a duplicate key, shadowed by the earlier mapping
+				}
+			}
+			
+			i = (i + 1) & mask;
+		}
+		
+		const entry e = { hash, position + 1 };
+		
+		its_entries[ i ] = e;
+		
+		++its_key_count;
+	}
+	
+	void array_index::append( Value* slot )
+	{
+		its_slots.push_back( slot );
+		
+		if ( keyed() )
+		{
+			insert_key( its_slots.size() - 1 );
+		}
+	}
+	
+	void array_index::index_keys()
+	{
+		for ( unsigned long i = 0;  i < its_slots.size();  ++i )
+		{
+			Expr* expr = its_slots[ i ]->expr();
+			
+			if ( expr == 0  ||  expr->op != Op_mapping )  // NULL
+			{
+				THROW( "non-mapping in table" );
+			}
+		}
+		
+		unsigned long n = 8;
+		
+		while ( n * 3 < its_slots.size() * 4 )
+		{
+			n *= 2;
+		}
+		
+		its_entries.assign( n, entry() );
+		
+		its_key_count = 0;
+		
+		for ( unsigned long i = 0;  i < its_slots.size();  ++i )
+		{
+			insert_key( i );
+		}
+	}
+	
+	void array_index::discard_keys()
+	{
+		its_entries.clear();
+		
+		its_key_count = 0;
+	}
+	
+	Value* array_index::find( const Value& key ) const
+	{
+		const unsigned long hash = hash_key( key );
+		const unsigned long mask = its_entries.size() - 1;
+		
+		for ( unsigned long i = hash & mask;  ;  i = (i + 1) & mask )
+		{
+			const entry& e = its_entries[ i ];
+			
+			if ( e.position == 0 )
+			{
+				return 0;  // NULL
+			}
+			
+			Value* slot = its_slots[ e.position - 1 ];
+			
+			if ( e.hash == hash  &&  equal_keys( key, slot_key( slot ) ) )
+			{
+				return slot;
+			}
+		}
+	}
+	
+	void append_to_index( array_index& index, Value& list, bool exclusive )
+	{
+		/*
+			Index the elements of list, unsharing each node along the way if
+			the index is to be exclusive.
+		*/
+		
+		Value* it = &list;
+		
+		while ( it->listexpr() != 0 )  // NULL
+		{
+			if ( exclusive )
+			{
+				it->unshare();
+			}
+			
+			Expr* node = it->expr();
+			
+			index.append( &node->left );
+			
+			it = &node->right;
+		}
+		
+		index.append( it );
+	}
+	
+	static
+	bool attach_index( Expr* array_expr, array_index* old, array_index* index )
+	{
+	#ifdef __RELIX__
+		
+		if ( array_expr->index != old )
+		{
+			return false;
+		}
+		
+		array_expr->index = index;
+		
+		return true;
+		
+	#else
+		
+		return array_expr->index.compare_exchange_strong( old, index );
+		
+	#endif
+	}
+	
+	array_index& lookup_index( Expr* array_expr )
+	{
+		if ( array_index* index = array_expr->index )
+		{
+			return *index;
+		}
+		
+		array_index* index = new array_index( false );
+		
+		append_to_index( *index, array_expr->right, false );
+		
+		if ( ! attach_index( array_expr, 0, index ) )  // NULL
+		{
+			// Another thread attached an index first.
+			
+			delete index;
+			
+			index = array_expr->index;
+		}
+		
+		return *index;
+	}
+	
+	const array_index& keyed_index( Expr* array_expr )
+	{
+		array_index* old = array_expr->index;
+		
+		if ( old  &&  old->keyed() )
+		{
+			return *old;
+		}
+		
+		/*
+			Other threads may be reading an index without keys, so build a
+			keyed one and attach it in the other's place.  The old one lives
+			on until the array is modified or destroyed.
+		*/
+		
+		array_index* index = new array_index( false );
+		
+		try
+		{
+			append_to_index( *index, array_expr->right, false );
+			
+			index->index_keys();
+		}
+		catch ( ... )
+		{
+			delete index;
+			
+			throw;
+		}
+		
+		index->retain( old );
+		
+		while ( ! attach_index( array_expr, old, index ) )
+		{
+			old = array_expr->index;
+			
+			if ( old->keyed() )
+			{
+				index->retain( 0 );  // NULL
+				
+				delete index;
+				
+				return *old;
+			}
+			
+			index->retain( old );
+		}
+		
+		return *index;
+	}
+	
+	array_index& exclusive_index( Expr* array_expr )
+	{
+		array_index* index = array_expr->index;
+		
+		if ( index  &&  index->exclusive()  &&  ! array_expr->right.is_shared() )
+		{
+			return *index;
+		}
+		
+		discard_array_index( array_expr );
+		
+		index = new array_index( true );
+		
+		append_to_index( *index, array_expr->right, true );
+		
+		array_expr->index = index;
+		
+		return *index;
+	}
+	
+}
@@ -0,0 +1,164 @@
+/*
+	array-index.hh
+	--------------
+*/
+
+#ifndef VLIB_ARRAYINDEX_HH
+#define VLIB_ARRAYINDEX_HH
+
+// Standard C++
+#include <vector>
+
+// vlib
+#include "vlib/value.hh"
+
+
+namespace vlib
+{
+	
+	/*
+		An array_index is attached to the Expr of an array and holds, in
+		order, the address of each Value in the array's list that holds an
+		element.  The list remains the array's representation -- the index
+		only spares walking it, and holds no references of its own.  A stack
+		frame's symbol list is indexed the same way.
+		
+		The array of a table may also have its keys hashed.  Only the first
+		mapping for any key is indexed, as with a linear search from the
+		front.
+		
+		An exclusive index was built by unsharing each node of the list, so
+		its slots may be modified in place, as long as the head of the list
+		remains unshared.  A non-exclusive index is only good for lookups.
+		
+		Anything that modifies an indexed array other than through its
+		index has to discard the index.  Anything that hands out the array's
+		list itself, from which a later node can be retained while the head
+		is released, has to disown it (see release_list()).
+		
+		A shared array may be read by several threads at once, so a reader
+		never modifies an index that's already attached.  It builds a new
+		one completely and then attaches it atomically (see lookup_index()
+		and keyed_index()).  Only an exclusive index is modified in place,
+		and only by the array's sole owner.
+	*/
+	
+#ifdef __RELIX__
+	
+	typedef bool exclusive_flag;
+	
+#else
+	
+	// release_list() demotes an index that other threads may be reading.
+	typedef boost::atomic< bool > exclusive_flag;
+	
+#endif
+	
+	class array_index
+	{
+		private:
+			struct entry
+			{
+				unsigned long  hash;
+				unsigned long  position;
+			};
+			
+			std::vector< Value* >  its_slots;
+			std::vector< entry  >  its_entries;
+			
+			unsigned long   its_key_count;
+			exclusive_flag  it_is_exclusive;
+			
+			/*
+				A lookup-only index replaced by this one, which readers on
+				other threads might still be using.  It's deleted with this.
+			*/
+			
+			array_index*  its_predecessor;
+			
+			// non-copyable
+			array_index           ( const array_index& );
+			array_index& operator=( const array_index& );
+			
+			void grow();
+			
+			void insert_key( unsigned long position );
+		
+		public:
+			array_index( bool exclusive );
+			
+			~array_index();
+			
+			bool exclusive() const  { return it_is_exclusive; }
+			
+			void retain( array_index* predecessor )
+			{
+				its_predecessor = predecessor;
+			}
+			
+			void disown()  { it_is_exclusive = false; }
+			
+			unsigned long size() const  { return its_slots.size(); }
+			
+			Value* slot( unsigned long i ) const  { return its_slots[ i ]; }
+			
+			Value* last() const  { return its_slots.back(); }
+			
+			void append( Value* slot );
+			
+			void move_last( Value* slot )  { its_slots.back() = slot; }
+			
+			bool keyed() const  { return ! its_entries.empty(); }
+			
+			void index_keys();
+			
+			void discard_keys();
+			
+			Value* find( const Value& key ) const;
+	};
+	
+	unsigned long hash_key( const Value& key );
+	
+	bool equal_keys( const Value& a, const Value& b );
+	
+	/*
+		An array is indexed when it's first updated, or first read beyond
+		this many elements.
+	*/
+	
+	const unsigned long max_unindexed_array_size = 8;
+	
+	array_index& lookup_index( Expr* array_expr );
+	
+	const array_index& keyed_index( Expr* array_expr );
+	
+	array_index& exclusive_index( Expr* array_expr );
+	
+	void append_to_index( array_index& index, Value& list, bool exclusive );
+	
+	inline
+	void discard_array_index( Expr* expr )
+	{
+		array_index* index = expr->index;
+		
+		expr->index = 0;  // NULL
+		
+		delete index;
+	}
+	
+	inline
+	const Value& release_list( Expr* array_expr )
+	{
+		array_index* index = array_expr->index;
+		
+		if ( index  &&  index->exclusive() )
+		{
+			index->disown();
+		}
+		
+		return array_expr->right;
+	}
+	
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "bignum/integer.hh"
 
 // vlib
+#include "vlib/array-index.hh"
 #include "vlib/assign.hh"
 #include "vlib/list-utils.hh"
 #include "vlib/throw.hh"
@@ -35,6 +36,18 @@ namespace vlib
 		{
 			if ( expr->op == Op_array )
 			{
+				if ( expr->index  ||  i >= max_unindexed_array_size )
+				{
+					const array_index& index = lookup_index( expr );
+					
+					if ( i >= index.size() )
+					{
+						return Value_empty_list;
+					}
+					
+					return *index.slot( i );
+				}
+				
 				return get_nth( expr->right, i );
 			}
 			
@@ -194,11 +207,42 @@ namespace vlib
 		}
 	}
 	
+	unsigned long array_length( Expr* array_expr )
+	{
+		if ( array_expr->index == 0 )  // NULL
+		{
+			const unsigned long n = count( array_expr->right );
+			
+			if ( n <= max_unindexed_array_size )
+			{
+				return n;
+			}
+		}
+		
+		return lookup_index( array_expr ).size();
+	}
+	
 	Value* get_array_subscript_addr( Expr* array_expr, const Value& index )
 	{
-		Value& list = array_expr->right;
+		/*
+			Always update through an exclusive index, even for a small array.
+			Unsharing only a prefix of the list (as get_nth_mutable() does)
+			would leave its remainder shared with whatever array the list was
+			copied from, whose own exclusive index would then be wrong.
+		*/
 		
-		return &get_nth_mutable( list, subscript_integer( index ) );
+		const unsigned i = subscript_integer( index );
+		
+		array_index& elements = exclusive_index( array_expr );
+		
+		elements.discard_keys();  // the element might be a table's mapping
+		
+		if ( i >= elements.size() )
+		{
+			throw mutable_list_overrun();
+		}
+		
+		return elements.slot( i );
 	}
 	
 	void push( const Target& target, const Value& list )
@@ -227,7 +271,22 @@ namespace vlib
 			}
 		}
 		
-		splice_lists( expr->right, list );
+		if ( is_empty_list( list ) )
+		{
+			return;
+		}
+		
+		array_index& index = exclusive_index( expr );
+		
+		Value* last = index.last();
+		
+		*last = Value( *last, list );
+		
+		Expr* node = last->expr();
+		
+		index.move_last( &node->left );
+		
+		append_to_index( index, node->right, true );
 	}
 	
 }
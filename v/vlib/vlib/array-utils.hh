@@ -28,6 +28,8 @@ namespace vlib
 	
 	void get_array_index_type( const Value& array_type, const Value*& base_type );
 	
+	unsigned long array_length( Expr* array_expr );
+	
 	Value* get_array_subscript_addr( Expr* array_expr, const Value& index );
 	
 	void push( const Target& array_target, const Value& list );
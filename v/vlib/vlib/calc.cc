@@ -9,6 +9,7 @@
 #include "debug/assert.hh"
 
 // vlib
+#include "vlib/array-index.hh"
 #include "vlib/array-utils.hh"
 #include "vlib/assign.hh"
 #include "vlib/compare.hh"
@@ -20,11 +21,11 @@
 #include "vlib/list-utils.hh"
 #include "vlib/map-reduce.hh"
 #include "vlib/os.hh"
-#include "vlib/return.hh"
 #include "vlib/string-utils.hh"
 #include "vlib/table-utils.hh"
 #include "vlib/targets.hh"
 #include "vlib/throw.hh"
+#include "vlib/transfer.hh"
 #include "vlib/types.hh"
 #include "vlib/type_info.hh"
 #include "vlib/dispatch/compare.hh"
@@ -67,7 +68,7 @@ namespace vlib
 		{
 			if ( expr->op == Op_array )
 			{
-				return expr->right;
+				return release_list( expr );
 			}
 			
 			if ( expr->op == Op_empower )
@@ -234,11 +235,6 @@ namespace vlib
 			return generic_deref( v );
 		}
 		
-		if ( op == Op_return )
-		{
-			throw transfer_via_return( v, source_spec() );
-		}
-		
 		if ( op == Op_throw )
 		{
 			throw user_exception( v, source_spec() );
@@ -259,7 +255,7 @@ namespace vlib
 					
 					if ( op == Op_begin )
 					{
-						return Iterator( expr->right );
+						return Iterator( release_list( expr ) );
 					}
 					
 					THROW( "unary operator not defined for arrays" );
@@ -370,7 +366,7 @@ namespace vlib
 		
 		if ( name == "length" )
 		{
-			return Integer( count( expr->right ) );
+			return Integer( array_length( expr ) );
 		}
 		
 		THROW( "nonexistent array member" );
@@ -625,6 +621,26 @@ namespace vlib
 		return Value_empty_list;
 	}
 	
+	static
+	bool loop_ends( Value& result )
+	{
+		/*
+			A `break` or `continue` from the loop body is consumed here.  A
+			`return` also ends the loop, but is passed on as its result.
+		*/
+		
+		const op_type op = result.as< Transfer >().op();
+		
+		if ( op == Op_return )
+		{
+			return true;
+		}
+		
+		result = Value_nothing;
+		
+		return op == Op_break;
+	}
+	
 	static
 	Value calc_while( const Value& _do_ )
 	{
@@ -639,8 +655,20 @@ namespace vlib
 		
 		Value result;
 		
-		while ( do_block( expr->left ).to< Boolean >() )
+		while ( true )
 		{
+			const Value test = do_block( expr->left );
+			
+			if ( is_transfer( test ) )
+			{
+				return test;
+			}
+			
+			if ( ! test.to< Boolean >() )
+			{
+				break;
+			}
+			
 			periodic_yield();
 			
 			try
@@ -657,6 +685,11 @@ namespace vlib
 				
 				continue;
 			}
+			
+			if ( is_transfer( result )  &&  loop_ends( result ) )
+			{
+				return result;
+			}
 		}
 		
 		return result;
@@ -679,7 +712,7 @@ namespace vlib
 		
 		Value result;
 		
-		do
+		while ( true )
 		{
 			periodic_yield();
 			
@@ -694,11 +727,25 @@ namespace vlib
 			catch ( const transfer_via_continue& )
 			{
 				result = Value_nothing;
-				
-				continue;
+			}
+			
+			if ( is_transfer( result )  &&  loop_ends( result ) )
+			{
+				return result;
+			}
+			
+			const Value test = do_block( expr->right );
+			
+			if ( is_transfer( test ) )
+			{
+				return test;
+			}
+			
+			if ( ! test.to< Boolean >() )
+			{
+				break;
 			}
 		}
-		while ( do_block( expr->right ).to< Boolean >() );
 		
 		return result;
 	}
@@ -732,7 +779,7 @@ namespace vlib
 		}
 		catch ( const user_exception& e )
 		{
-			return call_function( catcher, e.object );
+			return invoke_function( catcher, e.object );
 		}
 	}
 	
@@ -745,6 +792,11 @@ namespace vlib
 	            op_type       op,
 	            const Value&  right )
 	{
+		if ( const Value result = small_integer_calc( left, op, right ) )
+		{
+			return result;
+		}
+		
 		if ( const dispatch* methods = left.dispatch_methods() )
 		{
 			if ( const operators* ops = methods->ops )
@@ -776,16 +828,6 @@ namespace vlib
 			return calc_do( left );
 		}
 		
-		if ( op == Op_break )
-		{
-			throw transfer_via_break( source_spec() );
-		}
-		
-		if ( op == Op_continue )
-		{
-			throw transfer_via_continue( source_spec() );
-		}
-		
 		if ( op == Op_try )
 		{
 			return calc_try( left );
@@ -793,7 +835,7 @@ namespace vlib
 		
 		if ( op == Op_function  ||  op == Op_named_unary )
 		{
-			return call_function( left, right );
+			return invoke_function( left, right );
 		}
 		
 		if ( op == Op_map )
@@ -1022,7 +1064,7 @@ namespace vlib
 		}
 		
 		THROW( "operator not defined on mixed types" );
-		
+	
 	no_op:
 		
 		return Value( left, op, right );
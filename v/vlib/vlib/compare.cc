@@ -10,6 +10,7 @@
 #include "vlib/value.hh"
 #include "vlib/dispatch/compare.hh"
 #include "vlib/dispatch/dispatch.hh"
+#include "vlib/types/integer.hh"
 
 
 namespace vlib
@@ -20,6 +21,14 @@ namespace vlib
 	
 	cmp_t compare( const Value& a, const Value& b )
 	{
+		if ( is_small_integer( a )  &&  is_small_integer( b ) )
+		{
+			const long x = a.number().clipped_to< long >();
+			const long y = b.number().clipped_to< long >();
+			
+			return (x > y) - (x < y);
+		}
+		
 		if ( a.type() != b.type() )
 		{
 			THROW( "mismatched types in compare()" );
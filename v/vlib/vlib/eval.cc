@@ -18,6 +18,7 @@
 #include "vlib/targets.hh"
 #include "vlib/throw.hh"
 #include "vlib/tracker.hh"
+#include "vlib/transfer.hh"
 #include "vlib/types.hh"
 #include "vlib/dispatch/dispatch.hh"
 #include "vlib/dispatch/operators.hh"
@@ -346,6 +347,11 @@ namespace vlib
 			{
 				validate( left );
 				
+				if ( transfers_control( op ) )
+				{
+					return Transfer( left, op, source );
+				}
+				
 				return calc( left, op, right );
 			}
 			
@@ -9,6 +9,7 @@
 #include "debug/assert.hh"
 
 // vlib
+#include "vlib/array-index.hh"
 #include "vlib/array-utils.hh"
 #include "vlib/assert.hh"
 #include "vlib/collectible.hh"
@@ -22,6 +23,7 @@
 #include "vlib/symdesc.hh"
 #include "vlib/throw.hh"
 #include "vlib/tracker.hh"
+#include "vlib/transfer.hh"
 #include "vlib/type_info.hh"
 #include "vlib/dispatch/dispatch.hh"
 #include "vlib/dispatch/operators.hh"
@@ -106,6 +108,23 @@ namespace vlib
 	static
 	Value_in_flight execute( const Value& tree, const Value& stack );
 	
+	static
+	void index_frame( const Value& stack )
+	{
+		/*
+			Index a long frame while it's new.  Once the frame is shared,
+			resolve_symdesc() only reads the index, and another thread may
+			be reading it too.
+		*/
+		
+		Expr* expr = stack.expr();
+		
+		if ( count( expr->right ) > max_unindexed_array_size )
+		{
+			lookup_index( expr );
+		}
+	}
+	
 	static
 	Value_in_flight invoke_block( const Value& block, const Value& arguments )
 	{
@@ -135,6 +154,8 @@ namespace vlib
 		const Value new_frame( underscore, unshare_symbols( rest( locals ) ) );
 		const Value new_stack( caller, Op_frame, new_frame );
 		
+		index_frame( new_stack );
+		
 		const Value& unshared_locals = is_call ? new_frame
 		                                       : new_frame.expr()->right;
 		
@@ -229,7 +250,27 @@ namespace vlib
 	};
 	
 	static
-	void run_for_loop( const Value& do_clause, const Value& stack )
+	bool loop_ends( Value& result )
+	{
+		/*
+			A `break` or `continue` from the loop body is consumed here.  A
+			`return` also ends the loop, and is passed on as its result.
+		*/
+		
+		const op_type op = result.as< Transfer >().op();
+		
+		if ( op == Op_return )
+		{
+			return true;
+		}
+		
+		result = Value();
+		
+		return op == Op_break;
+	}
+	
+	static
+	Value run_for_loop( const Value& do_clause, const Value& stack )
 	{
 		/*
 			right operand is `x in container do {...}`:
@@ -322,10 +363,14 @@ namespace vlib
 		ASSERT( expr->op == Op_frame );
 		
 		
+		discard_array_index( expr );
+		
 		Value& stack_frame = expr->right;
 		
 		Value& variable = get_nth_mutable( stack_frame, index );
 		
+		index_frame( stack_next );
+		
 		if ( const dispatch* methods = container.get().dispatch_methods() )
 		{
 			if ( const operators* ops = methods->ops )
@@ -347,23 +392,30 @@ namespace vlib
 						
 						if ( is_empty_list( result ) )
 						{
-							return;
+							return Value();
 						}
 						
 						temporary tmp( result );
 						
+						Value transfer;
+						
 						try
 						{
-							v_invoke( activation );
+							transfer = v_invoke( activation );
 						}
 						catch ( const transfer_via_break& )
 						{
-							return;
+							return Value();
 						}
 						catch ( const transfer_via_continue& )
 						{
 							continue;  // no-op
 						}
+						
+						if ( is_transfer( transfer )  &&  loop_ends( transfer ) )
+						{
+							return transfer;
+						}
 					}
 				}
 			}
@@ -375,9 +427,11 @@ namespace vlib
 		{
 			variable.sym()->deref_unsafe() = it.use();
 			
+			Value transfer;
+			
 			try
 			{
-				v_invoke( activation );
+				transfer = v_invoke( activation );
 			}
 			catch ( const transfer_via_break& )
 			{
@@ -387,17 +441,31 @@ namespace vlib
 			{
 				continue;  // no-op
 			}
+			
+			if ( is_transfer( transfer )  &&  loop_ends( transfer ) )
+			{
+				return transfer;
+			}
 		}
+		
+		return Value();
 	}
 	
 	static
-	void test_assertion( const Expr* expr, const Value& stack )
+	Value test_assertion( const Expr* expr, const Value& stack )
 	{
 		const Value& test = expr->right;
 		
 		const Value result = execute( test, stack );
 		
+		if ( is_transfer( result ) )
+		{
+			return result;
+		}
+		
 		check_assertion_result( test, result, expr->source );
+		
+		return nothing;
 	}
 	
 	static
@@ -407,6 +475,11 @@ namespace vlib
 		
 		const Value result = execute( expr->left, stack );
 		
+		if ( is_transfer( result ) )
+		{
+			return result;
+		}
+		
 		const bool truth = result.to< Boolean >();
 		
 		if ( truth == bail )
@@ -422,8 +495,10 @@ namespace vlib
 	{
 		Symbol& xsym = *exports.sym();
 		
-		if ( Expr* expr = xsym.get().expr() )
+		if ( xsym.get().expr() )
 		{
+			Expr* expr = xsym.deref().expr();
+			
 			ASSERT( expr->op == Op_export );
 			ASSERT( is_array( expr->right ) );
 			
@@ -439,6 +514,11 @@ namespace vlib
 		xsym.deref() = Value( Op_export, symbol );
 	}
 	
+	/*
+		resolve_symbol_expr() returns a transfer (from a subscript, say)
+		instead of the target, which the caller has to pass on.
+	*/
+	
 	static
 	Value resolve_symbol_expr( const Value& v, const Value& stack )
 	{
@@ -455,6 +535,11 @@ namespace vlib
 				
 				const Value type = execute( expr->right, stack );
 				
+				if ( is_transfer( type ) )
+				{
+					return type;
+				}
+				
 				return eval( left, Op_denote, type, expr->source );
 			}
 			
@@ -467,7 +552,7 @@ namespace vlib
 			{
 				const Value& right = resolve_symbol( expr->right, stack );
 				
-				export_symbol( expr->left, right );
+				export_symbol( resolve_symbol( expr->left, stack ), right );
 				
 				return right;
 			}
@@ -476,6 +561,11 @@ namespace vlib
 			{
 				const Value reference = execute( expr->right, stack );
 				
+				if ( is_transfer( reference ) )
+				{
+					return reference;
+				}
+				
 				if ( Expr* rexpr = reference.expr() )
 				{
 					return rexpr->right;
@@ -484,10 +574,22 @@ namespace vlib
 			
 			const bool exec = expr->op != Op_list;
 			
-			return Value( resolve_symbol_expr( expr->left, stack ),
-			              expr->op,
-			              exec ? execute            ( expr->right, stack ).get()
-			                   : resolve_symbol_expr( expr->right, stack ) );
+			const Value left = resolve_symbol_expr( expr->left, stack );
+			
+			if ( is_transfer( left ) )
+			{
+				return left;
+			}
+			
+			const Value right = exec ? execute            ( expr->right, stack ).get()
+			                         : resolve_symbol_expr( expr->right, stack );
+			
+			if ( is_transfer( right ) )
+			{
+				return right;
+			}
+			
+			return Value( left, expr->op, right );
 		}
 		
 		if ( v.type() != Value_symbol  &&  ! is_etc( v ) )
@@ -547,9 +649,7 @@ namespace vlib
 		{
 			if ( expr->op == Op_for )
 			{
-				run_for_loop( expr->right, stack );
-				
-				return Value();
+				return run_for_loop( expr->right, stack );
 			}
 			
 			if ( expr->op == Op_module )
@@ -578,14 +678,21 @@ namespace vlib
 			{
 				const Value& symbol = expr->right;
 				
-				export_symbol( expr->left, resolve_symbol( symbol, stack ) );
+				const Value& exports = resolve_symbol( expr->left, stack );
+				
+				export_symbol( exports, resolve_symbol( symbol, stack ) );
 				
 				return execute( symbol, stack );
 			}
 			
 			if ( expr->op == Op_end )
 			{
-				execute( expr->left, stack );
+				const Value_in_flight first = execute( expr->left, stack );
+				
+				if ( is_transfer( first ) )
+				{
+					return first;
+				}
 				
 				return execute( expr->right, stack );
 			}
@@ -620,9 +727,7 @@ namespace vlib
 			
 			if ( expr->op == Op_assert )
 			{
-				test_assertion( expr, stack );
-				
-				return nothing;
+				return test_assertion( expr, stack );
 			}
 			
 			if ( expr->op == Op_and  ||  expr->op == Op_or )
@@ -636,7 +741,14 @@ namespace vlib
 			{
 				const Value& v = expr->right;
 				
-				return Value( Op_unary_refer, resolve_symbol_expr( v, stack ) );
+				const Value target = resolve_symbol_expr( v, stack );
+				
+				if ( is_transfer( target ) )
+				{
+					return target;
+				}
+				
+				return Value( Op_unary_refer, target );
 			}
 			
 			const Value* left  = &expr->left;
@@ -657,10 +769,21 @@ namespace vlib
 			
 			if ( is_right_varop( expr->op ) )
 			{
-				return eval( resolve_symbol_expr( *left, stack ),
-				             expr->op,
-				             resolve_symbol_expr( *right, stack ),
-				             expr->source );
+				const Value a = resolve_symbol_expr( *left, stack );
+				
+				if ( is_transfer( a ) )
+				{
+					return a;
+				}
+				
+				const Value b = resolve_symbol_expr( *right, stack );
+				
+				if ( is_transfer( b ) )
+				{
+					return b;
+				}
+				
+				return eval( a, expr->op, b, expr->source );
 			}
 			
 			if ( is_left_varop( expr->op )  &&  ! is_type_annotation( *left ) )
@@ -670,10 +793,21 @@ namespace vlib
 					THROW( "function prototypes are unimplemented" );
 				}
 				
-				return eval( resolve_symbol_expr( *left, stack ),
-				             expr->op,
-				             execute( *right, stack ),
-				             expr->source );
+				const Value_in_flight b = execute( *right, stack );
+				
+				if ( is_transfer( b ) )
+				{
+					return b;
+				}
+				
+				const Value a = resolve_symbol_expr( *left, stack );
+				
+				if ( is_transfer( a ) )
+				{
+					return a;
+				}
+				
+				return eval( a, expr->op, b, expr->source );
 			}
 			
 			/*
@@ -682,10 +816,21 @@ namespace vlib
 				only make this easier.
 			*/
 			
-			return eval( execute( *left, stack ),
-			             expr->op,
-			             execute( *right, stack ),
-			             expr->source );
+			const Value_in_flight b = execute( *right, stack );
+			
+			if ( is_transfer( b ) )
+			{
+				return b;
+			}
+			
+			const Value_in_flight a = execute( *left, stack );
+			
+			if ( is_transfer( a ) )
+			{
+				return a;
+			}
+			
+			return eval( a, expr->op, b, expr->source );
 		}
 		
 		const Value& resolved = resolve_symbol( tree, stack );
@@ -693,13 +838,18 @@ namespace vlib
 		return eval( resolved );
 	}
 	
-	Value execute( const Value& root )
+	static
+	Value execute_root( const Value& root, const Value& symbols )
 	{
 		scoped_root scope( root );
 		
 		Expr* expr = root.expr();
 		
-		const Value stack( NIL, Op_frame, expr->left );
+		const Value stack( NIL, Op_frame, symbols );
+		
+		index_frame( stack );
+		
+		scoped_root frame( stack );
 		
 		try
 		{
@@ -714,4 +864,14 @@ namespace vlib
 		return Value();
 	}
 	
+	Value execute( const Value& root )
+	{
+		return execute_root( root, root.expr()->left );
+	}
+	
+	Value execute_afresh( const Value& root )
+	{
+		return execute_root( root, unshare_symbols( root.expr()->left ) );
+	}
+	
 }
@@ -26,6 +26,13 @@ namespace vlib
 	
 	Value execute( const Value& root );
 	
+	/*
+		execute_afresh() runs a tree with its own copy of the top-level
+		variables, leaving the tree as it was found, so it can be run again.
+	*/
+	
+	Value execute_afresh( const Value& root );
+	
 }
 
 #endif
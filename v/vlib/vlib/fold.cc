@@ -14,6 +14,7 @@
 #include "vlib/scope.hh"
 #include "vlib/symbol.hh"
 #include "vlib/throw.hh"
+#include "vlib/transfer.hh"
 #include "vlib/types/boolean.hh"
 #include "vlib/types/string.hh"
 #include "vlib/types/symdesc.hh"
@@ -218,7 +219,12 @@ namespace vlib
 		{
 			try
 			{
-				return compute( a, op, b );
+				const Value result = compute( a, op, b );
+				
+				if ( ! is_transfer( result ) )
+				{
+					return result;
+				}
 			}
 			catch ( const user_exception& )
 			{
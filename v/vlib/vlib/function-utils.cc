@@ -9,6 +9,7 @@
 #include "vlib/list-utils.hh"
 #include "vlib/os.hh"
 #include "vlib/throw.hh"
+#include "vlib/transfer.hh"
 #include "vlib/dispatch/dispatch.hh"
 #include "vlib/dispatch/operators.hh"
 #include "vlib/types/integer.hh"
@@ -17,7 +18,7 @@
 namespace vlib
 {
 	
-	Value call_function( const Value& f, const Value& arguments )
+	Value invoke_function( const Value& f, const Value& arguments )
 	{
 		if ( const dispatch* methods = f.dispatch_methods() )
 		{
@@ -39,9 +40,14 @@ namespace vlib
 		{
 			if ( expr->op == Op_multiply )
 			{
-				return call_function( expr->left,
-				                      call_function( expr->right,
-				                                     arguments ) );
+				const Value inner = invoke_function( expr->right, arguments );
+				
+				if ( is_transfer( inner ) )
+				{
+					return inner;
+				}
+				
+				return invoke_function( expr->left, inner );
 			}
 			
 			if ( expr->op == Op_empower )
@@ -54,7 +60,12 @@ namespace vlib
 				{
 					periodic_yield();
 					
-					result = call_function( expr->left, result );
+					result = invoke_function( expr->left, result );
+					
+					if ( is_transfer( result ) )
+					{
+						break;
+					}
 				}
 				
 				return result;
@@ -63,7 +74,7 @@ namespace vlib
 			const Value& method = expr->left;
 			const Value& object = expr->right;
 			
-			return call_function( method, make_list( object, arguments ) );
+			return invoke_function( method, make_list( object, arguments ) );
 		}
 		
 		THROW( "attempted call of non-function" );
@@ -71,4 +82,16 @@ namespace vlib
 		return Value();  // not reached
 	}
 	
+	Value call_function( const Value& f, const Value& arguments )
+	{
+		const Value result = invoke_function( f, arguments );
+		
+		if ( is_transfer( result ) )
+		{
+			throw_transfer( result );
+		}
+		
+		return result;
+	}
+	
 }
@@ -13,6 +13,14 @@
 namespace vlib
 {
 	
+	/*
+		invoke_function() may return a Transfer (see transfer.hh), which
+		the interpreter passes on.  call_function() is for native callers,
+		and throws it instead.
+	*/
+	
+	Value invoke_function( const Value& f, const Value& arguments );
+	
 	Value call_function( const Value& f, const Value& arguments );
 	
 }
@@ -17,7 +17,8 @@ namespace vlib
 	class Value_in_flight
 	{
 		private:
-			Value its_value;
+			Value      its_value;
+			root_link  its_root;  // must follow its_value
 			
 			// non-assignable
 			Value_in_flight& operator=( const Value_in_flight& );
@@ -25,19 +26,14 @@ namespace vlib
 		public:
 			Value_in_flight( const Value& v ) : its_value( v )
 			{
-				add_root( its_value );
-			}
-			
-			~Value_in_flight()
-			{
-				del_root( its_value );
+				its_root.link( its_value );
 			}
 			
 			Value_in_flight( const Value_in_flight& that )
 			:
 				its_value( that.its_value )
 			{
-				add_root( its_value );
+				its_root.link( its_value );
 			}
 			
 			const Value& get() const  { return its_value; }
@@ -6,21 +6,25 @@
 #include "vlib/interpret.hh"
 
 // POSIX
+#include <pthread.h>
 #include <unistd.h>
 
 // Standard C
 #include <stdlib.h>
 
 // Standard C++
+#include <map>
 #include <new>
 
 // must
+#include "must/pthread.h"
 #include "must/write.h"
 
 // gear
 #include "gear/inscribe_decimal.hh"
 
 // plus
+#include "plus/string.hh"
 #include "plus/var_string.hh"
 
 // vlib
@@ -31,6 +35,7 @@
 #include "vlib/return.hh"
 #include "vlib/startup.hh"
 #include "vlib/string-utils.hh"
+#include "vlib/transfer.hh"
 
 
 #define STR_LEN( s )  "" s, (sizeof s - 1)
@@ -45,7 +50,7 @@ namespace vlib
 	void fail( const char* msg, unsigned len )
 	{
 		must_write( STDERR_FILENO, msg, len );
-	
+		
 		exit( 1 );
 	}
 	
@@ -76,10 +81,118 @@ namespace vlib
 		fail( msg, src );
 	}
 	
+	static
+	Value analyzed( const char* program, const char* file, lexical_scope* globals )
+	{
+		return analyze( parse( program, file ), globals );
+	}
+	
+	/*
+		The program cache holds the most recently analyzed tree for each
+		file, along with the text it came from.  A tree is only reused for
+		identical text, and is analyzed outside of the lock, so a thread
+		that misses doesn't hold up the others.
+		
+		A script can eval() under any number of file names, so the cache is
+		limited to max_cached_programs files.  Adding another evicts the one
+		least recently used.
+	*/
+	
+	const std::size_t max_cached_programs = 64;
+	
+	struct cached_program
+	{
+		plus::string   text;
+		Value          tree;
+		unsigned long  last_use;
+	};
+	
+	typedef std::map< plus::string, cached_program > program_cache;
+	
+	static program_cache    the_program_cache;
+	static unsigned long    program_cache_clock;
+	static pthread_mutex_t  program_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+	
+	class program_cache_lock
+	{
+		private:
+			// non-copyable
+			program_cache_lock           ( const program_cache_lock& );
+			program_cache_lock& operator=( const program_cache_lock& );
+		
+		public:
+			program_cache_lock()
+			{
+				must_pthread_mutex_lock( &program_cache_mutex );
+			}
+			
+			~program_cache_lock()
+			{
+				must_pthread_mutex_unlock( &program_cache_mutex );
+			}
+	};
+	
+	static
+	void evict_least_recently_used_program()
+	{
+		typedef program_cache::iterator Iter;
+		
+		Iter oldest = the_program_cache.begin();
+		
+		for ( Iter it = oldest;  it != the_program_cache.end();  ++it )
+		{
+			if ( it->second.last_use < oldest->second.last_use )
+			{
+				oldest = it;
+			}
+		}
+		
+		the_program_cache.erase( oldest );
+	}
+	
+	static
+	Value cached_tree( const char* program, const char* file )
+	{
+		const plus::string key = file;
+		
+		{
+			program_cache_lock lock;
+			
+			program_cache::iterator it = the_program_cache.find( key );
+			
+			if ( it != the_program_cache.end()  &&  it->second.text == program )
+			{
+				it->second.last_use = ++program_cache_clock;
+				
+				return it->second.tree;
+			}
+		}
+		
+		const Value tree = analyzed( program, file, NULL );
+		
+		program_cache_lock lock;
+		
+		if ( the_program_cache.size() >= max_cached_programs  &&
+		     the_program_cache.find( key ) == the_program_cache.end() )
+		{
+			evict_least_recently_used_program();
+		}
+		
+		cached_program& cached = the_program_cache[ key ];
+		
+		cached.text     = program;
+		cached.tree     = tree;
+		cached.last_use = ++program_cache_clock;
+		
+		return tree;
+	}
+	
+	static
 	Value interpret( const char*     program,
 	                 const char*     file,
 	                 lexical_scope*  globals,
-	                 error_handler   handler )
+	                 error_handler   handler,
+	                 bool            cached )
 	{
 		if ( handler == NULL )
 		{
@@ -90,7 +203,15 @@ namespace vlib
 		{
 			static int startup = (inject_startup_header( globals ), 0);
 			
-			return execute( analyze( parse( program, file ), globals ) );
+			const Value result = cached ? execute_afresh( cached_tree( program, file ) )
+			                            : execute( analyzed( program, file, globals ) );
+			
+			if ( is_transfer( result ) )
+			{
+				throw_transfer( result );  // reported below
+			}
+			
+			return result;
 		}
 		catch ( const std::bad_alloc& )
 		{
@@ -155,4 +276,19 @@ namespace vlib
 		return Value();
 	}
 	
+	Value interpret( const char*     program,
+	                 const char*     file,
+	                 lexical_scope*  globals,
+	                 error_handler   handler )
+	{
+		return interpret( program, file, globals, handler, false );
+	}
+	
+	Value interpret_cached( const char*    program,
+	                        const char*    file,
+	                        error_handler  handler )
+	{
+		return interpret( program, file, NULL, handler, true );
+	}
+	
 }
@@ -23,6 +23,16 @@ namespace vlib
 	                 lexical_scope*  globals = 0,
 	                 error_handler   handler = 0 );  // NULL
 	
+	/*
+		interpret_cached() reuses the analyzed tree from a previous call
+		with the same file and program text, running it with fresh
+		top-level variables each time.  Only the default globals are used.
+	*/
+	
+	Value interpret_cached( const char*    program,
+	                        const char*    file,
+	                        error_handler  handler = 0 );  // NULL
+	
 }
 
 #endif
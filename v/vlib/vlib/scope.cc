@@ -18,12 +18,14 @@ namespace vlib
 	
 	const Value& lexical_scope::resolve( const plus::string& name, int depth )
 	{
-		if ( const Value& sym = locate_keyword( name ) )
+		const symbol_key key( name );
+		
+		if ( const Value& sym = locate_keyword( key ) )
 		{
 			return sym;
 		}
 		
-		if ( const Value& sym = locate_symbol( its_symbol_cache, name ) )
+		if ( const Value& sym = its_symbol_cache.locate( key ) )
 		{
 			return sym;
 		}
@@ -32,7 +34,7 @@ namespace vlib
 		
 		do
 		{
-			int offset = scope->its_symbols.offset( name );
+			int offset = scope->its_symbols.offset( key );
 			
 			if ( offset < 0 )
 			{
@@ -49,9 +51,7 @@ namespace vlib
 			const Value s = immutable ? symbol
 			                          : make_metasymbol( name, depth, offset );
 			
-			its_symbol_cache.push_back( s );
-			
-			return its_symbol_cache.back();
+			return its_symbol_cache.add( key, s );
 		}
 		while ( scope != NULL );
 		
@@ -61,12 +61,14 @@ namespace vlib
 	const Value& lexical_scope::declare( const plus::string&  name,
 	                                     symbol_type          type )
 	{
-		if ( locate_keyword( name ) )
+		const symbol_key key( name );
+		
+		if ( locate_keyword( key ) )
 		{
 			THROW( "keyword override attempt" );
 		}
 		
-		return its_symbols.create( name, type );
+		return its_symbols.create( key, type );
 	}
 	
 	const Value& lexical_scope::immortalize_constant( int i, const Value& v )
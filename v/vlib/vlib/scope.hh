@@ -20,7 +20,7 @@ namespace vlib
 			lexical_scope* its_parent;
 			
 			symbol_table  its_symbols;
-			Symbols       its_symbol_cache;
+			symbol_table  its_symbol_cache;
 		
 		private:
 			// non-copyable
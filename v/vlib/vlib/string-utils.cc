@@ -565,6 +565,24 @@ namespace vlib
 		return result;
 	}
 	
+	unsigned long hash_bytes( const plus::string& s )
+	{
+		// FNV-1a
+		
+		unsigned long hash = 2166136261u;
+		
+		const char* p   = s.data();
+		const char* end = p + s.size();
+		
+		while ( p < end )
+		{
+			hash ^= (unsigned char) *p++;
+			hash *= 16777619u;
+		}
+		
+		return hash;
+	}
+	
 	plus::string repeat( const plus::string& s, plus::string::size_type n )
 	{
 		if ( n > 0x7fffffff )
@@ -639,7 +657,7 @@ namespace vlib
 		do
 		{
 			p = mempcpy( p, glue );
-			
+		
 		loop_start:
 			
 			p = maker.make_string( p, it.use(), Stringified_to_print );
@@ -43,6 +43,8 @@ namespace vlib
 		return make_string( v, Stringified_to_pack );
 	}
 	
+	unsigned long hash_bytes( const plus::string& s );
+	
 	plus::string repeat( const plus::string& s, plus::string::size_type n );
 	
 	plus::string join( const plus::string& glue, const Value& v, unsigned n );
@@ -20,8 +20,8 @@ namespace vlib
 	enum mark_type
 	{
 		Mark_none,   // not participating in GC
-		Mark_white,  // not reached
-		Mark_black,  // reachable from a root
+		Mark_white,  // not reached             (white and black trade
+		Mark_black,  // reachable from a root   places; see tracker.cc)
 	};
 	
 	class Symbol
@@ -6,6 +6,7 @@
 #include "vlib/symbol_table.hh"
 
 // vlib
+#include "vlib/string-utils.hh"
 #include "vlib/throw.hh"
 #include "vlib/types/term.hh"
 
@@ -16,41 +17,114 @@ namespace vlib
 	static symbol_table keyword_symbol_table;
 	
 	
+	symbol_key::symbol_key( const plus::string& s )
+	:
+		name( s ),
+		hash( hash_bytes( s ) )
+	{
+	}
+	
 	void symbol_table::define_constant( const char* name, const Value& v )
 	{
 		Constant constant( name );
 		
 		constant.sym()->assign( v );
 		
-		its_symbols.push_back( constant );
+		append( constant, hash_bytes( constant.sym()->name() ) );
 	}
 	
-	static
-	const Value* find_symbol( const Symbols& symbols, const plus::string& name )
+	void symbol_table::grow()
 	{
-		typedef Symbols::const_iterator Iter;
+		std::vector< unsigned > slots( its_slots.empty() ? 16
+		                                                 : its_slots.size() * 2 );
 		
-		Iter begin = symbols.begin();
-		Iter it    = symbols.end();
+		its_slots.swap( slots );
 		
-		while ( it != begin )
+		for ( unsigned i = 0;  i < its_symbols.size();  ++i )
 		{
-			const Value& v = *--it;
-			
-			Symbol* sym = v.sym();
+			insert( i );
+		}
+	}
+	
+	/*
+		A later symbol with the same name replaces the earlier one in the
+		index, as with a linear search from the end.
+	*/
+	
+	void symbol_table::insert( unsigned offset )
+	{
+		const unsigned long hash = its_hashes[ offset ];
+		const unsigned long mask = its_slots.size() - 1;
+		
+		const plus::string& name = its_symbols[ offset ].sym()->name();
+		
+		unsigned long i = hash & mask;
+		
+		while ( unsigned other = its_slots[ i ] )
+		{
+			if ( its_hashes[ other - 1 ] == hash )
+			{
+				if ( its_symbols[ other - 1 ].sym()->name() == name )
+				{
+					break;
+				}
+			}
 			
-			if ( name == sym->name() )
+			i = (i + 1) & mask;
+		}
+		
+		its_slots[ i ] = offset + 1;
+	}
+	
+	const Value& symbol_table::append( const Value& symbol, unsigned long hash )
+	{
+		its_symbols.push_back( symbol );
+		its_hashes .push_back( hash   );
+		
+		if ( its_symbols.size() * 2 > its_slots.size() )
+		{
+			grow();  // reinserts everything, including the new symbol
+		}
+		else
+		{
+			insert( its_symbols.size() - 1 );
+		}
+		
+		return its_symbols.back();
+	}
+	
+	const Value* symbol_table::find( const symbol_key& key ) const
+	{
+		if ( its_slots.empty() )
+		{
+			return NULL;
+		}
+		
+		const unsigned long mask = its_slots.size() - 1;
+		
+		unsigned long i = key.hash & mask;
+		
+		while ( unsigned offset = its_slots[ i ] )
+		{
+			if ( its_hashes[ offset - 1 ] == key.hash )
 			{
-				return &v;
+				const Value& v = its_symbols[ offset - 1 ];
+				
+				if ( v.sym()->name() == key.name )
+				{
+					return &v;
+				}
 			}
+			
+			i = (i + 1) & mask;
 		}
 		
 		return NULL;
 	}
 	
-	int symbol_table::offset( const plus::string& name ) const
+	int symbol_table::offset( const symbol_key& key ) const
 	{
-		if ( const Value* it = find_symbol( its_symbols, name ) )
+		if ( const Value* it = find( key ) )
 		{
 			return it - &*its_symbols.begin();
 		}
@@ -58,9 +132,9 @@ namespace vlib
 		return -1;
 	}
 	
-	const Value& locate_symbol( const Symbols& syms, const plus::string& name )
+	const Value& symbol_table::locate( const symbol_key& key ) const
 	{
-		if ( const Value* it = find_symbol( syms, name ) )
+		if ( const Value* it = find( key ) )
 		{
 			return *it;
 		}
@@ -68,9 +142,9 @@ namespace vlib
 		return NIL;
 	}
 	
-	const Value& symbol_table::create( const plus::string& name, symbol_type type )
+	const Value& symbol_table::create( const symbol_key& key, symbol_type type )
 	{
-		if ( const Value* it = find_symbol( its_symbols, name ) )
+		if ( const Value* it = find( key ) )
 		{
 			const Value& symbol = *it;
 			
@@ -86,9 +160,7 @@ namespace vlib
 			THROW( "duplicate symbol" );
 		}
 		
-		its_symbols.push_back( Term( type, name ) );
-		
-		return its_symbols.back();
+		return append( Term( type, key.name ), key.hash );
 	}
 	
 	Value symbol_table::list() const
@@ -113,9 +185,9 @@ namespace vlib
 		return result;
 	}
 	
-	const Value& locate_keyword( const plus::string& name )
+	const Value& locate_keyword( const symbol_key& key )
 	{
-		return keyword_symbol_table.locate( name );
+		return keyword_symbol_table.locate( key );
 	}
 	
 	const Value& create_keyword( const plus::string& name )
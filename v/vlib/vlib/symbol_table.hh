@@ -21,34 +21,57 @@ namespace vlib
 	
 	typedef std::vector< Value > Symbols;
 	
-	const Value& locate_symbol( const Symbols& syms, const plus::string& name );
+	/*
+		A name is hashed once per lookup, and the hash is reused for each
+		table searched.  Names are compared only when their hashes match.
+	*/
+	
+	struct symbol_key
+	{
+		const plus::string&  name;
+		const unsigned long  hash;
+		
+		symbol_key( const plus::string& s );
+	};
 	
 	class symbol_table
 	{
 		private:
-			Symbols its_symbols;
+			Symbols                       its_symbols;
+			std::vector< unsigned long >  its_hashes;
+			std::vector< unsigned     >  its_slots;  // offsets plus one
+			
+			void grow();
+			
+			void insert( unsigned offset );
+			
+			const Value& append( const Value& symbol, unsigned long hash );
+			
+			const Value* find( const symbol_key& key ) const;
 		
 		public:
 			void define_constant( const char* name, const Value& v );
 			
-			int offset( const plus::string& name ) const;
+			int offset( const symbol_key& key ) const;
 			
 			Value list() const;
 			
-			const Value& locate( const plus::string& name ) const
+			const Value& locate( const symbol_key& key ) const;
+			
+			const Value& create( const symbol_key& key, symbol_type type );
+			
+			const Value& add( const symbol_key& key, const Value& symbol )
 			{
-				return locate_symbol( its_symbols, name );
+				return append( symbol, key.hash );
 			}
 			
-			const Value& create( const plus::string& name, symbol_type type );
-			
 			const Value& operator[]( std::size_t i ) const
 			{
 				return its_symbols[ i ];
 			}
 	};
 	
-	const Value& locate_keyword( const plus::string& name );
+	const Value& locate_keyword( const symbol_key& key );
 	const Value& create_keyword( const plus::string& name );
 	
 }
@@ -9,6 +9,7 @@
 #include "debug/assert.hh"
 
 // vlib
+#include "vlib/array-index.hh"
 #include "vlib/list-utils.hh"
 #include "vlib/stack.hh"
 #include "vlib/symbol.hh"
@@ -48,6 +49,15 @@ namespace vlib
 		
 		const Value& symbols = expr->right;
 		
+		// A long frame is indexed when it's created (see execute.cc).
+		
+		if ( const array_index* slots = expr->index )
+		{
+			ASSERT( index < slots->size() );
+			
+			return *slots->slot( index );
+		}
+		
 		ASSERT( index < count( symbols ) );
 		
 		return get_nth( symbols, index );
@@ -6,6 +6,7 @@
 #include "vlib/table-utils.hh"
 
 // vlib
+#include "vlib/array-index.hh"
 #include "vlib/array-utils.hh"
 #include "vlib/equal.hh"
 #include "vlib/list-utils.hh"
@@ -19,38 +20,36 @@ namespace vlib
 {
 	
 	static
-	bool equal_keys( const Value& a, const Value& b )
+	void index_keys( array_index& index )
 	{
-		if ( a.type() != b.type() )
+		if ( ! index.keyed() )
 		{
-			return false;
+			index.index_keys();
 		}
-		
-		switch ( a.type() )
-		{
-			case Value_boolean:
-			case Value_byte:
-			case Value_number:
-			case Value_mb32:
-			case Value_packed:
-				break;
-			
-			case Value_string:
-				return a.string() == b.string();
-			
-			default:
-				THROW( "unsupported key type" );
-		}
-		
-		return equal( a, b );
 	}
 	
 	Value keyed_subscript( const Value& array, const Value& key )
 	{
+		Expr* array_expr = array.expr();
+		
+		unsigned long n = 0;
+		
 		array_iterator it( array );
 		
 		while ( it )
 		{
+			if ( array_expr->index  ||  ++n > max_unindexed_array_size )
+			{
+				const array_index& index = keyed_index( array_expr );
+				
+				if ( const Value* slot = index.find( key ) )
+				{
+					return slot->expr()->right;
+				}
+				
+				break;
+			}
+			
 			const Value& mapping = it.use();
 			
 			if ( Expr* expr = mapping.expr() )
@@ -119,60 +118,40 @@ namespace vlib
 		return keyed_subscript( array, key );
 	}
 	
-	static
-	Value& find_key_mutable( Value& list, const Value& key )
-	{
-		Value* it = &list;
-		
-		while ( true )
-		{
-			Value& next = first_mutable( *it );
-			
-			if ( equal_keys( next.expr()->left, key ) )
-			{
-				return next.unshare().expr()->right;
-			}
-			
-			if ( it->listexpr() == 0 )
-			{
-				// Key not found; create a new mapping.
-				
-				*it = Value( *it, empty_list );
-				
-				return it->expr()->right;
-			}
-			
-			it = &rest_mutable( *it );
-		}
-	}
-	
 	Value* get_table_subscript_addr( Expr* array_expr, const Value& key )
 	{
 		Value& array = array_expr->right.unshare();
 		
-		Value* it;
-		
-		if ( ! is_empty_array( array ) )
+		if ( is_empty_array( array ) )
 		{
-			Value& list  = array.expr()->right;
-			
-			it = &find_key_mutable( list, key );
+			array = make_array( Value( key, Op_mapping, Value() ) );
 			
-			if ( ! is_empty_list( *it ) )
-			{
-				return it;
-			}
+			return &array.expr()->right.expr()->right;
 		}
-		else
+		
+		array_index& index = exclusive_index( array.expr() );
+		
+		index_keys( index );
+		
+		if ( Value* slot = index.find( key ) )
 		{
-			array = make_array( Value() );
-			
-			it = &array.expr()->right;
+			return &slot->unshare().expr()->right;
 		}
 		
-		*it = Value( key, Op_mapping, Value() );
+		// Key not found; append a new mapping.
+		
+		Value* last = index.last();
+		
+		*last = Value( *last, empty_list );
+		
+		Expr* node = last->expr();
+		
+		node->right = Value( key, Op_mapping, Value() );
+		
+		index.move_last( &node->left );
+		index.append   ( &node->right );
 		
-		return &it->expr()->right;
+		return &node->right.expr()->right;
 	}
 	
 }
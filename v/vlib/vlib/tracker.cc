@@ -7,8 +7,10 @@
 
 // POSIX
 #include <pthread.h>
+#include <sys/time.h>
 
 // Standard C++
+#include <algorithm>
 #include <vector>
 
 // must
@@ -32,10 +34,10 @@ namespace vlib
 {
 	
 	/*
-		Reset (all roots and tracked symbols):
-			clear -> PRUNE
-			white -> PRUNE
-			black -> white
+		Tracked symbols are either white (not reached) or black (reachable
+		from a root).  Rather than resetting every survivor of a cull to
+		white, which takes another full traversal, the two marks trade
+		meanings after each cull.
 		
 		Mark (roots only):
 			clear -> PRUNE
@@ -46,98 +48,266 @@ namespace vlib
 			clear -> PRUNE
 			white -> clear [removed]
 			black -> PRUNE
+		
+		A cull isn't incremental:  It marks and sweeps everything in one
+		pause, holding every root set's mutex.  Without write barriers, a
+		partial mark could miss a symbol stored behind it.
 	*/
 	
 	typedef std::vector< Value > tracked_set;
 	
 	static tracked_set tracked_symbols;
-	static tracked_set tracked_roots;
+	
+	static mark_type white = Mark_white;
+	static mark_type black = Mark_black;
 	
 	static size_t n_steps = 0;
 	static size_t n_culls = 0;
 	
+	static size_t n_collected = 0;
+	
+	static unsigned n_deferrals   = 0;
+	static bool     cull_deferred = false;
+	
+	static unsigned long last_pause    = 0;  // microseconds
+	static unsigned long longest_pause = 0;
+	static unsigned long total_pause   = 0;
+	
 	static pthread_mutex_t gc_mutex = PTHREAD_MUTEX_INITIALIZER;
 	
 	class gc_lock
 	{
 		private:
+			pthread_mutex_t& its_mutex;
+			
 			// non-copyable
 			gc_lock           ( const gc_lock& );
 			gc_lock& operator=( const gc_lock& );
 		
 		public:
-			gc_lock()   { must_pthread_mutex_lock  ( &gc_mutex ); }
-			~gc_lock()  { must_pthread_mutex_unlock( &gc_mutex ); }
+			gc_lock( pthread_mutex_t& mutex = gc_mutex ) : its_mutex( mutex )
+			{
+				must_pthread_mutex_lock( &its_mutex );
+			}
+			
+			~gc_lock()
+			{
+				must_pthread_mutex_unlock( &its_mutex );
+			}
 	};
 	
-	void gc_safe_overwrite( Value& dst, const Value& src )
+	/*
+		Each root_set is a circular list, linked through its head.  Its
+		mutex is held by the owning thread only while linking or unlinking,
+		and by the collector for the duration of a cull.
+	*/
+	
+	struct root_set
 	{
-		gc_lock lock;
+		pthread_mutex_t  mutex;
+		root_link        head;
+		size_t           count;
 		
-		dst = src;
-	}
+		root_set() : count()
+		{
+			must_pthread_mutex_init( &mutex, NULL );
+			
+			head.its_prev = &head;
+			head.its_next = &head;
+		}
+		
+		~root_set()
+		{
+			must_pthread_mutex_destroy( &mutex );
+		}
+		
+		void set_marks( mark_type old_mark, mark_type new_mark );
+		
+		void hand_over( root_set& heir );
+	};
 	
-	static inline
-	bool is_tracked( const Symbol* sym )
-	{
-		return sym->mark() != Mark_none;
-	}
+	typedef std::vector< root_set* > root_set_list;
 	
-	void track_symbol( const Value& v )
+	static root_set_list root_sets;  // guarded by gc_mutex
+	
+	static root_set shared_roots;
+	
+	void root_set::hand_over( root_set& heir )
 	{
-		ASSERT( is_symbol( v ) );
+		// Move all our links to heir, which the caller has locked.
 		
-		Symbol* sym = v.sym();
+		root_link* first = head.its_next;
+		root_link* last  = head.its_prev;
 		
-		ASSERT( sym );
+		for ( root_link* it = first;  it != &head;  it = it->its_next )
+		{
+			it->its_set = &heir;
+		}
+		
+		if ( first != &head )
+		{
+			last->its_next = heir.head.its_next;
+			first->its_prev = &heir.head;
+			
+			heir.head.its_next->its_prev = last;
+			heir.head.its_next = first;
+		}
+		
+		heir.count += count;
+		
+		head.its_prev = &head;
+		head.its_next = &head;
+		
+		count = 0;
+	}
+	
+	static
+	void release_root_set( void* param )
+	{
+		root_set* set = (root_set*) param;
 		
 		gc_lock lock;
 		
-		if ( ! is_tracked( sym ) )
+		if ( set->count != 0 )
 		{
-			tracked_symbols.push_back( v );
+			/*
+				Something outlives the thread and still refers to one of its
+				roots.  Keep the roots, but in the shared set, so that this
+				one can go.
+			*/
 			
-			sym->set_mark( Mark_black );
+			gc_lock shared_lock( shared_roots.mutex );
+			gc_lock set_lock( set->mutex );
+			
+			set->hand_over( shared_roots );
+		}
+		
+		typedef root_set_list::iterator Iter;
+		
+		for ( Iter it = root_sets.begin();  it != root_sets.end();  ++it )
+		{
+			if ( *it == set )
+			{
+				root_sets.erase( it );
+				
+				break;
+			}
 		}
+		
+		delete set;
 	}
 	
-	void add_root( const Value& v )
+	static
+	pthread_key_t make_root_set_key()
 	{
-		if ( v.is_cycle_free() )
+		pthread_key_t key;
+		
+		int err = pthread_key_create( &key, &release_root_set );
+		
+		ASSERT( err == 0 );
+		
+		gc_lock lock;
+		
+		root_sets.push_back( &shared_roots );
+		
+		return key;
+	}
+	
+	static
+	root_set* thread_root_set()
+	{
+		static pthread_key_t key = make_root_set_key();
+		
+		if ( void* set = pthread_getspecific( key ) )
 		{
-			return;
+			return (root_set*) set;
 		}
 		
+		root_set* set = new root_set;
+		
+		pthread_setspecific( key, set );
+		
 		gc_lock lock;
 		
-		tracked_roots.push_back( v );
+		root_sets.push_back( set );
+		
+		return set;
+	}
+	
+	void root_link::attach( root_set* set, const Value& v )
+	{
+		its_value = &v;
+		
+		gc_lock lock( set->mutex );
+		
+		its_set  = set;
+		its_prev = &set->head;
+		its_next = set->head.its_next;
+		
+		its_next->its_prev = this;
+		its_prev->its_next = this;
+		
+		++set->count;
+	}
+	
+	void root_link::detach()
+	{
+		gc_lock lock( its_set->mutex );
+		
+		its_prev->its_next = its_next;
+		its_next->its_prev = its_prev;
+		
+		--its_set->count;
+		
+		its_set = NULL;
 	}
 	
-	void del_root( const Value& v )
+	void root_link::link( const Value& v )
 	{
-		if ( v.is_cycle_free() )
+		if ( ! v.is_cycle_free() )
 		{
-			return;
+			attach( thread_root_set(), v );
 		}
-		
+	}
+	
+	void root_link::link_shared( const Value& v )
+	{
+		if ( ! v.is_cycle_free() )
+		{
+			thread_root_set();  // ensure that shared_roots is registered
+			
+			attach( &shared_roots, v );
+		}
+	}
+	
+	void gc_safe_overwrite( Value& dst, const Value& src )
+	{
 		gc_lock lock;
 		
-		typedef tracked_set::iterator Iter;
+		dst = src;
+	}
+	
+	static inline
+	bool is_tracked( const Symbol* sym )
+	{
+		return sym->mark() != Mark_none;
+	}
+	
+	void track_symbol( const Value& v )
+	{
+		ASSERT( is_symbol( v ) );
 		
-		const Iter begin = tracked_roots.begin();
+		Symbol* sym = v.sym();
 		
-		Iter it = tracked_roots.end();
+		ASSERT( sym );
 		
-		while ( it > begin )
+		gc_lock lock;
+		
+		if ( ! is_tracked( sym ) )
 		{
-			--it;
+			tracked_symbols.push_back( v );
 			
-			if ( &it->dereference< int >() == &v.dereference< int >() )
-			{
-				tracked_roots.erase( it );
-				
-				break;
-			}
+			sym->set_mark( white );  // like the survivors of the last cull
 		}
 	}
 	
@@ -179,20 +349,11 @@ namespace vlib
 		}
 	}
 	
-	static
-	void set_marks( tracked_set& set, mark_type old_mark, mark_type new_mark )
+	void root_set::set_marks( mark_type old_mark, mark_type new_mark )
 	{
-		typedef tracked_set::iterator Iter;
-		
-		const Iter begin = set.begin();
-		
-		Iter it = set.end();
-		
-		while ( it > begin )
+		for ( root_link* it = head.its_next;  it != &head;  it = it->its_next )
 		{
-			--it;
-			
-			set_marks( *it, old_mark, new_mark );
+			vlib::set_marks( *it->its_value, old_mark, new_mark );
 		}
 	}
 	
@@ -203,7 +364,7 @@ namespace vlib
 		
 		while ( Symbol* sym = next_symbol( it ) )
 		{
-			if ( sym->mark() == Mark_white )
+			if ( sym->mark() == white )
 			{
 				garbage.push_back( sym->vtype() );
 				garbage.push_back( sym->get() );
@@ -262,14 +423,43 @@ namespace vlib
 	static
 	void cull_unreachable_objects( tracked_set& garbage )
 	{
-		// Reset
-		set_marks( tracked_symbols, Mark_black, Mark_white );
-		set_marks( tracked_roots,   Mark_black, Mark_white );
+		typedef root_set_list::iterator Iter;
+		
+		// Threads may not link or unlink roots until the sweep is done.
+		
+		for ( Iter it = root_sets.begin();  it != root_sets.end();  ++it )
+		{
+			must_pthread_mutex_lock( &(*it)->mutex );
+		}
 		
 		// Mark
-		set_marks( tracked_roots, Mark_white, Mark_black );
+		for ( Iter it = root_sets.begin();  it != root_sets.end();  ++it )
+		{
+			(*it)->set_marks( white, black );
+		}
 		
 		sweep( garbage );
+		
+		for ( Iter it = root_sets.begin();  it != root_sets.end();  ++it )
+		{
+			must_pthread_mutex_unlock( &(*it)->mutex );
+		}
+		
+		// The survivors are all black now, and become the new white.
+		
+		using std::swap;
+		
+		swap( white, black );
+	}
+	
+	static
+	unsigned long microseconds()
+	{
+		timeval tv;
+		
+		gettimeofday( &tv, NULL );
+		
+		return tv.tv_sec * 1000000ul + tv.tv_usec;
 	}
 	
 	void cull_unreachable_objects()
@@ -278,14 +468,84 @@ namespace vlib
 		
 		gc_lock lock;
 		
+		if ( tracked_symbols.empty() )
+		{
+			return;  // Nothing is collectible, so there's nothing to mark.
+		}
+		
+		if ( n_deferrals )
+		{
+			cull_deferred = true;
+			
+			return;
+		}
+		
+		const unsigned long start = microseconds();
+		
 		cull_unreachable_objects( garbage );
 		
+		last_pause = microseconds() - start;
+		
+		total_pause += last_pause;
+		
+		if ( last_pause > longest_pause )
+		{
+			longest_pause = last_pause;
+		}
+		
+		n_collected += garbage.size() / 2;
+		
 		++n_culls;
 		
 		// release lock
 		// dispose garbage
 	}
 	
+	gc_deferral::gc_deferral()
+	{
+		gc_lock lock;  // wait for a cull in progress
+		
+		++n_deferrals;
+	}
+	
+	gc_deferral::~gc_deferral()
+	{
+		bool cull;
+		
+		{
+			gc_lock lock;
+			
+			cull = --n_deferrals == 0  &&  cull_deferred;
+			
+			if ( cull )
+			{
+				cull_deferred = false;
+			}
+		}
+		
+		if ( cull )
+		{
+			cull_unreachable_objects();
+		}
+	}
+	
+	static
+	size_t count_roots()
+	{
+		gc_lock lock;
+		
+		size_t total = 0;
+		
+		typedef root_set_list::const_iterator Iter;
+		
+		for ( Iter it = root_sets.begin();  it != root_sets.end();  ++it )
+		{
+			total += (*it)->count;
+		}
+		
+		return total;
+	}
+	
 	struct garbage_collector
 	{
 		~garbage_collector()
@@ -316,7 +576,12 @@ namespace vlib
 		
 		if ( name == "roots" )
 		{
-			return Integer( tracked_roots.size() );
+			return Integer( count_roots() );
+		}
+		
+		if ( name == "threads" )
+		{
+			return Integer( root_sets.size() - 1 );  // minus shared_roots
 		}
 		
 		if ( name == "steps" )
@@ -329,6 +594,28 @@ namespace vlib
 			return Integer( n_culls );
 		}
 		
+		if ( name == "collected" )
+		{
+			return Integer( n_collected );
+		}
+		
+		// pause times are in microseconds
+		
+		if ( name == "pause" )
+		{
+			return Integer( last_pause );
+		}
+		
+		if ( name == "longest" )
+		{
+			return Integer( longest_pause );
+		}
+		
+		if ( name == "paused" )
+		{
+			return Integer( total_pause );
+		}
+		
 		if ( name == "cull" )
 		{
 			return Proc( proc_cull );
@@ -12,34 +12,91 @@ namespace vlib
 	
 	class Value;
 	struct namespace_info;
+	struct root_set;
 	
 	void gc_safe_overwrite( Value& dst, const Value& src );
 	
 	void track_symbol( const Value& v );
 	
-	void add_root( const Value& v );
-	void del_root( const Value& v );
+	/*
+		A root_link keeps a value reachable for as long as it's linked.
+		Each thread links its roots into its own set, and only a collection
+		in progress contends for it.  Linking and unlinking take constant
+		time.  A root that might be unlinked by a different thread than the
+		one that linked it (e.g. a thread's function, released by whichever
+		thread joins it) must be linked with link_shared() instead.
+	*/
 	
-	void cull_unreachable_objects();
-	
-	class scoped_root
+	class root_link
 	{
 		private:
-			const Value& its_root;
+			root_link*    its_prev;
+			root_link*    its_next;
+			root_set*     its_set;
+			const Value*  its_value;
+			
+			friend struct root_set;
 			
 			// non-copyable
-			scoped_root           ( const scoped_root& );
-			scoped_root& operator=( const scoped_root& );
+			root_link           ( const root_link& );
+			root_link& operator=( const root_link& );
+			
+			void attach( root_set* set, const Value& v );
+			void detach();
 		
 		public:
-			scoped_root( const Value& root ) : its_root( root )
+			root_link() : its_set()
+			{
+			}
+			
+			~root_link()
 			{
-				add_root( root );
+				unlink();
 			}
 			
-			~scoped_root()
+			void link       ( const Value& v );
+			void link_shared( const Value& v );
+			
+			void unlink()
+			{
+				if ( its_set )
+				{
+					detach();
+				}
+			}
+	};
+	
+	void cull_unreachable_objects();
+	
+	/*
+		While any gc_deferral exists, a cull is postponed until the last one
+		is destroyed.  Threads working on the same computation hold values
+		in places that aren't roots (e.g. a function's return value on its
+		way to the caller), which is only safe as long as no other thread
+		can cull in the meantime.
+	*/
+	
+	class gc_deferral
+	{
+		private:
+			// non-copyable
+			gc_deferral           ( const gc_deferral& );
+			gc_deferral& operator=( const gc_deferral& );
+		
+		public:
+			gc_deferral();
+			~gc_deferral();
+	};
+	
+	class scoped_root
+	{
+		private:
+			root_link its_link;
+		
+		public:
+			scoped_root( const Value& root )
 			{
-				del_root( its_root );
+				its_link.link( root );
 			}
 	};
 	
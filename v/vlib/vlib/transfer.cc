@@ -0,0 +1,39 @@
+/*
+	transfer.cc
+	-----------
+*/
+
+#include "vlib/transfer.hh"
+
+// vlib
+#include "vlib/exceptions.hh"
+#include "vlib/return.hh"
+#include "vlib/dispatch/dispatch.hh"
+
+
+namespace vlib
+{
+	
+	void throw_transfer( const Value& transfer )
+	{
+		const Transfer& t = transfer.as< Transfer >();
+		
+		switch ( t.op() )
+		{
+			case Op_break:
+				throw transfer_via_break( t.source() );
+			
+			case Op_continue:
+				throw transfer_via_continue( t.source() );
+			
+			default:
+				throw transfer_via_return( t.object(), t.source() );
+		}
+	}
+	
+	const dispatch transfer_dispatch =
+	{
+		0,  // NULL
+	};
+	
+}
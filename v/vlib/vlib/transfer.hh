@@ -0,0 +1,70 @@
+/*
+	transfer.hh
+	-----------
+*/
+
+#ifndef VLIB_TRANSFER_HH
+#define VLIB_TRANSFER_HH
+
+// vlib
+#include "vlib/value.hh"
+
+
+namespace vlib
+{
+	
+	/*
+		A `break`, `continue`, or `return` evaluates to a Transfer, which
+		execute() and the control structures pass back up as their result,
+		skipping whatever remains, until the loop or function it's meant for
+		consumes it.  No exception is thrown for the normal case.
+		
+		Native code that calls into user code but can't pass a Transfer on
+		(e.g. `map`) calls call_function(), which rethrows it as one of the
+		transfer_via_* exceptions instead.
+	*/
+	
+	struct dispatch;
+	
+	extern const dispatch transfer_dispatch;
+	
+	inline
+	bool transfers_control( op_type op )
+	{
+		return op == Op_return  ||  op == Op_break  ||  op == Op_continue;
+	}
+	
+	class Transfer : public Value
+	{
+		public:
+			static bool test( const Value& v )
+			{
+				return v.dispatch_methods() == &transfer_dispatch;
+			}
+			
+			Transfer( const Value&        object,
+			          op_type             op,
+			          const source_spec&  source )
+			:
+				Value( object, op, nothing, &transfer_dispatch, source )
+			{
+			}
+			
+			op_type op() const  { return expr()->op; }
+			
+			const Value& object() const  { return expr()->left; }
+			
+			const source_spec& source() const  { return expr()->source; }
+	};
+	
+	inline
+	bool is_transfer( const Value& v )
+	{
+		return Transfer::test( v );
+	}
+	
+	void throw_transfer( const Value& transfer );
+	
+}
+
+#endif
@@ -5,6 +5,9 @@
 
 #include "vlib/types/integer.hh"
 
+// Standard C
+#include <limits.h>
+
 // iota
 #include "iota/char_types.hh"
 
@@ -42,6 +45,65 @@ namespace vlib
 		return x;
 	}
 	
+	static inline
+	bool is_half_word( long x )
+	{
+		const long half = 1L << (sizeof (long) * 4 - 1);
+		
+		return -half < x  &&  x < half;
+	}
+	
+	Value small_integer_calc( long a, op_type op, long b )
+	{
+		switch ( op )
+		{
+			case Op_add:
+				if ( b > 0 ? a > LONG_MAX - b : a < LONG_MIN - b )  break;
+				
+				return Integer( a + b );
+			
+			case Op_subtract:
+				if ( b < 0 ? a > LONG_MAX + b : a < LONG_MIN + b )  break;
+				
+				return Integer( a - b );
+			
+			case Op_multiply:
+				if ( ! is_half_word( a )  ||  ! is_half_word( b ) )  break;
+				
+				return Integer( a * b );
+			
+			/*
+				C++98 leaves the rounding of negative quotients to the
+				implementation, so only nonnegative operands are covered.
+			*/
+			
+			case Op_DIV:
+				if ( a < 0  ||  b <= 0 )  break;
+				
+				return Integer( a / b );
+			
+			case Op_remain:
+				if ( a < 0  ||  b <= 0 )  break;
+				
+				return Integer( a % b );
+			
+			case Op_equal:    return Boolean( a == b );
+			case Op_unequal:  return Boolean( a != b );
+			
+			case Op_lt:   return Boolean( a <  b );
+			case Op_lte:  return Boolean( a <= b );
+			case Op_gt:   return Boolean( a >  b );
+			case Op_gte:  return Boolean( a >= b );
+			
+			case Op_cmp:  return Integer( (a > b) - (a < b) );
+			
+			default:
+				break;
+		}
+		
+		return Value();
+	}
+	
 	static
 	Value division( const bignum::integer& numer, const bignum::integer& denom )
 	{
@@ -262,7 +324,17 @@ namespace vlib
 		
 		const bignum::integer& i = target.addr->number();
 		
-		Integer result = i + step;
+		Value result;
+		
+		if ( is_small_integer( *target.addr ) )
+		{
+			result = small_integer_calc( i.clipped_to< long >(), Op_add, step );
+		}
+		
+		if ( ! result )
+		{
+			result = Integer( i + step );
+		}
 		
 		switch ( op )
 		{
@@ -297,16 +369,18 @@ namespace vlib
 	{
 		bool dividing = true;
 		
+		op_type small_op = Op_none;
+		
 		switch ( op )
 		{
-			case Op_increase_by:
-			case Op_decrease_by:
-			case Op_multiply_by:
-				dividing = false;
-				// fall through
+			case Op_increase_by:  small_op = Op_add;       dividing = false;  break;
+			case Op_decrease_by:  small_op = Op_subtract;  dividing = false;  break;
+			case Op_multiply_by:  small_op = Op_multiply;  dividing = false;  break;
+			
+			case Op_div_int_by:   small_op = Op_DIV;     break;
+			case Op_remain_by:    small_op = Op_remain;  break;
+			
 			case Op_divide_by:
-			case Op_div_int_by:
-			case Op_remain_by:
 				break;
 			
 			default:
@@ -318,6 +392,16 @@ namespace vlib
 			THROW( "numeric update requires numeric operands" );
 		}
 		
+		if ( small_op != Op_none )
+		{
+			if ( const Value result = small_integer_calc( *target.addr, small_op, b ) )
+			{
+				assign( target, result );
+				
+				return result;
+			}
+		}
+		
 		const bignum::integer& k = b.number();
 		
 		if ( dividing  &&  k.is_zero() )
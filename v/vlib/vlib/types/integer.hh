@@ -63,6 +63,36 @@ namespace vlib
 	
 	extern const type_info integer_vtype;
 	
+	/*
+		Integers that fit in a long are the common case (loop counters,
+		indices, etc.), and for them, arithmetic and comparison are done in
+		machine words.  small_integer_calc() returns a null Value if either
+		operand is too large, the op isn't covered, or the result would
+		overflow, in which case the caller falls back to bignum::integer.
+	*/
+	
+	inline
+	bool is_small_integer( const Value& v )
+	{
+		return v.dispatch_methods() == &integer_dispatch  &&
+		       v.number().demotes_to< long >();
+	}
+	
+	Value small_integer_calc( long a, op_type op, long b );
+	
+	inline
+	Value small_integer_calc( const Value& a, op_type op, const Value& b )
+	{
+		if ( is_small_integer( a )  &&  is_small_integer( b ) )
+		{
+			return small_integer_calc( a.number().clipped_to< long >(),
+			                           op,
+			                           b.number().clipped_to< long >() );
+		}
+		
+		return Value();
+	}
+	
 	struct bad_cast_thrower
 	{
 		void operator()() const;
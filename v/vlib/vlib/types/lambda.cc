@@ -10,6 +10,7 @@
 #include "vlib/peephole.hh"
 #include "vlib/return.hh"
 #include "vlib/throw.hh"
+#include "vlib/transfer.hh"
 #include "vlib/dispatch/dispatch.hh"
 #include "vlib/dispatch/operators.hh"
 
@@ -44,9 +45,11 @@ namespace vlib
 	static
 	Value call_lambda( const Value& lambda, const Value& arguments )
 	{
+		Value result;
+		
 		try
 		{
-			return call_function_body( lambda.expr()->right, arguments );
+			result = call_function_body( lambda.expr()->right, arguments );
 		}
 		catch ( const transfer_via_return& e )
 		{
@@ -61,7 +64,24 @@ namespace vlib
 			THROW( "`continue` used outside of loop" );
 		}
 		
-		return Value();
+		if ( is_transfer( result ) )
+		{
+			const Transfer& transfer = result.as< Transfer >();
+			
+			switch ( transfer.op() )
+			{
+				case Op_break:
+					THROW( "`break` used outside of loop" );
+				
+				case Op_continue:
+					THROW( "`continue` used outside of loop" );
+				
+				default:
+					return transfer.object();
+			}
+		}
+		
+		return result;
 	}
 	
 	static
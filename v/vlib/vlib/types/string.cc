@@ -8,11 +8,15 @@
 // more-libc
 #include "more/string.h"
 
+// plus
+#include "plus/var_string.hh"
+
 // vlib
 #include "vlib/list-utils.hh"
 #include "vlib/proc_info.hh"
 #include "vlib/quote.hh"
 #include "vlib/string-utils.hh"
+#include "vlib/target.hh"
 #include "vlib/throw.hh"
 #include "vlib/type_info.hh"
 #include "vlib/dispatch/dispatch.hh"
@@ -118,12 +122,51 @@ namespace vlib
 		return Value();
 	}
 	
+	static
+	void append_to_string( Value& target, const plus::string& s )
+	{
+		/*
+			Once the target has released its reference, the buffer is
+			extended in place if nothing else shares it, and grows with room
+			to spare, so a string built by repeated appends takes linear time.
+		*/
+		
+		plus::string old = target.string();
+		
+		target = String();
+		
+		plus::var_string buffer = old.move();
+		
+		buffer += s;
+		
+		target = String( buffer.move() );
+	}
+	
+	static
+	Value mutating_op_handler( op_type        op,
+	                           const Target&  target,
+	                           const Value&   x,
+	                           const Value&   b )
+	{
+		switch ( op )
+		{
+			case Op_push:
+				append_to_string( *target.addr, str( b ) );
+				return nothing;
+			
+			default:
+				break;
+		}
+		
+		return vbytes_mutating_op_handler( op, target, x, b );
+	}
+	
 	static const operators ops =
 	{
 		&unary_op_handler,
 		&binary_op_handler,
 		NULL,
-		&vbytes_mutating_op_handler,
+		&mutating_op_handler,
 	};
 	
 	const dispatch string_dispatch =
@@ -14,6 +14,9 @@
 // plus
 #include "plus/extent.hh"
 
+// vlib
+#include "vlib/array-index.hh"
+
 
 namespace vlib
 {
@@ -129,12 +132,13 @@ namespace vlib
 	Value::Value( const Value&        a,
 	              op_type             op,
 	              const Value&        b,
-	              const dispatch*     d )
+	              const dispatch*     d,
+	              const source_spec&  s )
 	:
 		its_box( sizeof (Expr), &pair_destructor, Value_pair )
 	{
 		its_dispatch = d;
-		new ((void*) its_box.pointer()) Expr( a, op, b );
+		new ((void*) its_box.pointer()) Expr( a, op, b, s );
 		
 		if ( a.is_cycle_free()  &&  b.is_cycle_free() )
 		{
@@ -211,6 +215,13 @@ namespace vlib
 			}
 			
 			its_box.unshare();
+			
+			if ( Expr* exp = expr() )
+			{
+				// The original keeps its array index.
+				
+				exp->index = NULL;
+			}
 		}
 		
 		return *this;
@@ -224,8 +235,14 @@ namespace vlib
 		op( op ),
 		left( a ),
 		right( b ),
-		source( s )
+		source( s ),
+		index( 0 )
+	{
+	}
+	
+	Expr::~Expr()
 	{
+		delete index;
 	}
 	
 	unsigned long area( const Value& v )
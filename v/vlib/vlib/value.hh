@@ -6,6 +6,11 @@
 #ifndef VLIB_VALUE_HH
 #define VLIB_VALUE_HH
 
+#ifndef __RELIX__
+// Boost
+#include <boost/atomic.hpp>
+#endif
+
 // plus
 #include "plus/string.hh"
 
@@ -35,8 +40,21 @@ namespace vlib
 	struct dispatch;
 	struct type_info;
 	struct Expr;
+	class array_index;
 	class Symbol;
 	
+#ifdef __RELIX__
+	
+	// MacRelix threading is cooperative and doesn't need atomic types.
+	typedef array_index* array_index_ptr;
+	
+#else
+	
+	// A reader on any thread may attach an index to a shared Expr.
+	typedef boost::atomic< array_index* > array_index_ptr;
+	
+#endif
+	
 	enum value_type
 	{
 		Value_NIL,
@@ -146,7 +164,8 @@ namespace vlib
 			Value( const Value&        a,
 			       op_type             op,
 			       const Value&        b,
-			       const dispatch*     d );
+			       const dispatch*     d,
+			       const source_spec&  s = source_spec() );
 			
 			Value( long n, destructor dtor, value_type t, const dispatch* d );
 			
@@ -175,6 +194,8 @@ namespace vlib
 		public:
 			bool has_extent() const  { return its_box.has_extent(); }
 			
+			bool is_shared() const  { return its_box.refcount() > 1; }
+			
 			bool is_cycle_free() const  { return flag_bit( Flag_cycle_free ); }
 			bool is_evaluated()  const  { return flag_bit( Flag_evaluated  ); }
 			
@@ -320,10 +341,14 @@ namespace vlib
 		
 		const source_spec source;
 		
+		array_index_ptr  index;  // see array-index.hh
+		
 		Expr( const Value&        a,
 		      op_type             op,
 		      const Value&        b,
 		      const source_spec&  s = source_spec() );
+		
+		~Expr();
 	};
 	
 	inline
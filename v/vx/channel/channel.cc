@@ -7,8 +7,10 @@
 
 // Standard C++
 #include <new>
+#include <vector>
 
 // vlib
+#include "vlib/array-utils.hh"
 #include "vlib/generic.hh"
 #include "vlib/list-utils.hh"
 #include "vlib/proc_info.hh"
@@ -16,6 +18,8 @@
 #include "vlib/dispatch/dispatch.hh"
 #include "vlib/dispatch/operators.hh"
 #include "vlib/dispatch/stringify.hh"
+#include "vlib/iterators/list_iterator.hh"
+#include "vlib/types/integer.hh"
 #include "vlib/types/proc.hh"
 
 // vx
@@ -79,13 +83,57 @@ namespace vlib
 	static
 	Value v_recv( const Value& v )
 	{
-		const Channel& channel = static_cast< const Channel& >( v );
+		// ch.recv() takes one element; ch.recv(n) takes up to n, as an array.
+		
+		const Channel& channel = static_cast< const Channel& >( first( v ) );
+		
+		const Value& n = rest( v );
+		
+		if ( is_empty_list( n ) )
+		{
+			return channel.get()->recv();
+		}
+		
+		if ( ! n.is< Integer >() )
+		{
+			THROW( "non-integer channel recv count" );
+		}
 		
-		return channel.get()->recv();
+		const bignum::integer& count = n.number();
+		
+		if ( count.is_negative()  ||  count.is_zero() )
+		{
+			THROW( "channel recv count must be positive" );
+		}
+		
+		std::size_t limit = std::size_t( -1 );
+		
+		if ( count.demotes_to< std::size_t >() )
+		{
+			limit = count.clipped_to< std::size_t >();
+		}
+		
+		return make_array( channel.get()->recv_list( limit ) );
+	}
+	
+	static
+	Value v_send( const Value& v )
+	{
+		// ch.send( a, b, c ) sends each argument, under a single lock.
+		
+		const Channel& channel = static_cast< const Channel& >( first( v ) );
+		
+		if ( ! channel.get()->send_list( rest( v ) ) )
+		{
+			THROW( "send to closed channel" );
+		}
+		
+		return nothing;
 	}
 	
 	static const proc_info proc_close = { "close", &v_close, NULL };
 	static const proc_info proc_recv  = { "recv",  &v_recv,  NULL };
+	static const proc_info proc_send  = { "send",  &v_send,  NULL };
 	
 	static
 	Value channel_member( const Value& obj, const plus::string& name )
@@ -95,6 +143,11 @@ namespace vlib
 			return bind_args( Proc( proc_recv ), obj );
 		}
 		
+		if ( name == "send" )
+		{
+			return bind_args( Proc( proc_send ), obj );
+		}
+		
 		if ( name == "close" )
 		{
 			return bind_args( Proc( proc_close ), obj );
@@ -149,14 +202,112 @@ namespace vlib
 		&ops,
 	};
 	
-	Channel::Channel()
+	Channel::Channel( std::size_t capacity )
 	:
 		Value( sizeof (channel_state),
 		       &generic_destructor< channel_state >,
 		       Value_other,
 		       &channel_dispatch )
 	{
-		new ((void*) pointer()) channel_state();
+		new ((void*) pointer()) channel_state( capacity );
 	}
 	
+	class selection
+	{
+		private:
+			channel_selector                its_selector;
+			std::vector< channel_state* >  its_channels;
+			
+			// non-copyable
+			selection           ( const selection& );
+			selection& operator=( const selection& );
+		
+		public:
+			selection()
+			{
+			}
+			
+			~selection();
+			
+			void add( channel_state* channel );
+			
+			void wait()  { its_selector.wait(); }
+	};
+	
+	selection::~selection()
+	{
+		typedef std::vector< channel_state* >::iterator Iter;
+		
+		for ( Iter it = its_channels.begin();  it != its_channels.end();  ++it )
+		{
+			(*it)->detach( &its_selector );
+		}
+	}
+	
+	void selection::add( channel_state* channel )
+	{
+		channel->attach( &its_selector );
+		
+		its_channels.push_back( channel );
+	}
+	
+	static
+	Value v_select( const Value& v )
+	{
+		/*
+			Wait until any of the channels has an element, and return it
+			mapped from its channel.  If they're all closed and drained,
+			return an empty list (like recv on a closed channel).
+			
+			The selector is attached before the channels are polled, so an
+			element sent after a channel was found empty isn't missed.
+		*/
+		
+		selection selected;
+		
+		for ( list_iterator it( v );  it;  ++it )
+		{
+			if ( ! it->is< Channel >() )
+			{
+				THROW( "select requires channels" );
+			}
+			
+			selected.add( static_cast< const Channel& >( *it ).get() );
+		}
+		
+		while ( true )
+		{
+			bool open = false;
+			
+			for ( list_iterator it( v );  it;  ++it )
+			{
+				const Channel& channel = static_cast< const Channel& >( *it );
+				
+				Value result;
+				
+				switch ( channel.get()->try_recv( result ) )
+				{
+					case Recv_ok:
+						return Value( channel, Op_mapping, result );
+					
+					case Recv_empty:
+						open = true;
+						break;
+					
+					case Recv_closed:
+						break;
+				}
+			}
+			
+			if ( ! open )
+			{
+				return empty_list;
+			}
+			
+			selected.wait();
+		}
+	}
+	
+	const proc_info proc_select = { "select", &v_select, NULL };
+	
 }
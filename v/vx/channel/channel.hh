@@ -6,6 +6,9 @@
 #ifndef CHANNEL_CHANNEL_HH
 #define CHANNEL_CHANNEL_HH
 
+// Standard C++
+#include <cstddef>
+
 // vlib
 #include "vlib/value.hh"
 
@@ -16,9 +19,12 @@ namespace vlib
 	class channel_state;
 	
 	struct dispatch;
+	struct proc_info;
 	
 	extern const dispatch channel_dispatch;
 	
+	extern const proc_info proc_select;
+	
 	class Channel : public Value
 	{
 		public:
@@ -27,7 +33,7 @@ namespace vlib
 				return v.dispatch_methods() == &channel_dispatch;
 			}
 			
-			Channel();
+			explicit Channel( std::size_t capacity = 0 );
 			
 			channel_state* get() const
 			{
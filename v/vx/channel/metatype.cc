@@ -71,6 +71,23 @@ namespace vlib
 				{
 					return Channel();
 				}
+				
+				if ( b.is< Integer >()  &&  ! b.number().is_negative() )
+				{
+					// buffer capacity, which past size_t is unlimited anyway
+					
+					const bignum::integer& n = b.number();
+					
+					std::size_t capacity = std::size_t( -1 );
+					
+					if ( n.demotes_to< std::size_t >() )
+					{
+						capacity = n.clipped_to< std::size_t >();
+					}
+					
+					return Channel( capacity );
+				}
+				
 				THROW( "invalid channel argument" );
 			
 			case Op_subscript:
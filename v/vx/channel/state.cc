@@ -5,6 +5,13 @@
 
 #include "state.hh"
 
+// Standard C++
+#include <algorithm>
+
+// vlib
+#include "vlib/iterators/list_builder.hh"
+#include "vlib/iterators/list_iterator.hh"
+
 
 namespace vlib
 {
@@ -12,6 +19,123 @@ namespace vlib
 	namespace p7 = poseven;
 	
 	
+	void channel_selector::notify()
+	{
+		p7::lock k( its_mutex );
+		
+		it_is_ready = true;
+		
+		its_cond.signal();
+	}
+	
+	void channel_selector::wait()
+	{
+		p7::lock k( its_mutex );
+		
+		while ( ! it_is_ready )
+		{
+			its_cond.wait( k );
+		}
+		
+		it_is_ready = false;
+	}
+	
+	const std::size_t initial_ring_size = 16;
+	
+	channel_state::channel_state( std::size_t capacity )
+	:
+		it_is_closed(),
+		its_recv_count(),
+		its_ring( std::min( capacity + (capacity == 0), initial_ring_size ) ),
+		its_links( new root_link[ its_ring.size() ] ),
+		its_capacity( capacity ),
+		its_head(),
+		its_count()
+	{
+	}
+	
+	channel_state::~channel_state()
+	{
+		delete [] its_links;
+	}
+	
+	void channel_state::notify_selectors()
+	{
+		typedef std::vector< channel_selector* >::iterator Iter;
+		
+		for ( Iter it = its_selectors.begin();  it != its_selectors.end();  ++it )
+		{
+			(*it)->notify();
+		}
+	}
+	
+	void channel_state::grow()
+	{
+		/*
+			Copy the elements to the front of a ring twice as large.  Each is
+			rooted in the new ring before it's unrooted in the old one.
+		*/
+		
+		const std::size_t size = its_ring.size();
+		
+		const std::size_t new_size = its_capacity - size > size ? size * 2
+		                                                        : its_capacity;
+		
+		std::vector< Value > ring( new_size );
+		
+		root_link* links = new root_link[ new_size ];
+		
+		for ( std::size_t i = 0;  i < its_count;  ++i )
+		{
+			ring[ i ] = its_ring[ (its_head + i) % size ];
+			
+			links[ i ].link_shared( ring[ i ] );
+		}
+		
+		delete [] its_links;
+		
+		its_links = links;
+		
+		its_ring.swap( ring );
+		
+		its_head = 0;
+	}
+	
+	void channel_state::put( const Value& v )
+	{
+		if ( its_count == its_ring.size() )
+		{
+			grow();
+		}
+		
+		const std::size_t size = its_ring.size();
+		
+		const std::size_t i = (its_head + its_count++) % size;
+		
+		its_ring[ i ] = v;
+		
+		its_links[ i ].link_shared( its_ring[ i ] );
+		
+		its_recv_cond.signal();
+		
+		notify_selectors();
+	}
+	
+	Value channel_state::take()
+	{
+		Value result;
+		
+		its_links[ its_head ].unlink();
+		
+		result.swap( its_ring[ its_head ] );
+		
+		its_head = (its_head + 1) % its_ring.size();
+		
+		--its_count;
+		
+		return result;
+	}
+	
 	void channel_state::close()
 	{
 		p7::lock k( its_mutex );
@@ -20,12 +144,12 @@ namespace vlib
 		
 		its_send_cond.broadcast();
 		its_recv_cond.broadcast();
+		
+		notify_selectors();
 	}
 	
-	bool channel_state::send( const Value& v )
+	bool channel_state::wait_to_send( const p7::lock& k )
 	{
-		p7::lock k( its_mutex );
-		
 		while ( true )
 		{
 			if ( it_is_closed )
@@ -33,14 +157,41 @@ namespace vlib
 				return false;
 			}
 			
-			if ( its_recv_count > 0  &&  its_element.type() == 0 )  break;
+			if ( can_send() )  break;
 			
 			its_send_cond.wait( k );
 		}
 		
-		its_element = v;
+		return true;
+	}
+	
+	bool channel_state::send( const Value& v )
+	{
+		p7::lock k( its_mutex );
+		
+		if ( ! wait_to_send( k ) )
+		{
+			return false;
+		}
+		
+		put( v );
 		
-		its_recv_cond.signal();
+		return true;
+	}
+	
+	bool channel_state::send_list( const Value& list )
+	{
+		p7::lock k( its_mutex );
+		
+		for ( list_iterator it( list );  it;  ++it )
+		{
+			if ( ! wait_to_send( k ) )
+			{
+				return false;
+			}
+			
+			put( *it );
+		}
 		
 		return true;
 	}
@@ -51,7 +202,7 @@ namespace vlib
 		
 		its_send_cond.signal();
 		
-		while ( ! it_is_closed  &&  its_element.type() == 0 )
+		while ( ! it_is_closed  &&  its_count == 0 )
 		{
 			++its_recv_count;
 			
@@ -60,19 +211,87 @@ namespace vlib
 			--its_recv_count;
 		}
 		
-		if ( its_element.type() == 0 )
+		if ( its_count == 0 )
 		{
 			// recv on a closed channel
 			return empty_list;
 		}
 		
-		Value result;
-		
-		result.swap( its_element );
+		Value result = take();
 		
 		its_send_cond.signal();
 		
 		return result;
 	}
 	
+	Value channel_state::recv_list( std::size_t n )
+	{
+		p7::lock k( its_mutex );
+		
+		its_send_cond.signal();
+		
+		while ( ! it_is_closed  &&  its_count == 0 )
+		{
+			++its_recv_count;
+			
+			its_recv_cond.wait( k );
+			
+			--its_recv_count;
+		}
+		
+		list_builder result;
+		
+		while ( n-- > 0  &&  its_count > 0 )
+		{
+			result.append( take() );
+		}
+		
+		its_send_cond.broadcast();
+		
+		return result.move();
+	}
+	
+	recv_status channel_state::try_recv( Value& result )
+	{
+		p7::lock k( its_mutex );
+		
+		if ( its_count == 0 )
+		{
+			return it_is_closed ? Recv_closed : Recv_empty;
+		}
+		
+		result = take();
+		
+		its_send_cond.signal();
+		
+		return Recv_ok;
+	}
+	
+	void channel_state::attach( channel_selector* selector )
+	{
+		p7::lock k( its_mutex );
+		
+		its_selectors.push_back( selector );
+		
+		++its_recv_count;
+		
+		its_send_cond.signal();
+	}
+	
+	void channel_state::detach( channel_selector* selector )
+	{
+		p7::lock k( its_mutex );
+		
+		typedef std::vector< channel_selector* >::iterator Iter;
+		
+		Iter it = std::find( its_selectors.begin(), its_selectors.end(), selector );
+		
+		if ( it != its_selectors.end() )
+		{
+			its_selectors.erase( it );
+			
+			--its_recv_count;
+		}
+	}
+	
 }
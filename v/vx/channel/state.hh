@@ -6,17 +6,63 @@
 #ifndef CHANNEL_STATE_HH
 #define CHANNEL_STATE_HH
 
+// Standard C++
+#include <vector>
+
 // poseven
 #include "poseven/types/cond.hh"
 #include "poseven/types/mutex.hh"
 
 // vlib
+#include "vlib/tracker.hh"
 #include "vlib/value.hh"
 
 
 namespace vlib
 {
 	
+	/*
+		A channel_selector is signaled whenever any channel it's attached
+		to receives an element or is closed.
+	*/
+	
+	class channel_selector
+	{
+		private:
+			poseven::mutex  its_mutex;
+			poseven::cond   its_cond;
+			bool            it_is_ready;
+			
+			// non-copyable
+			channel_selector           ( const channel_selector& );
+			channel_selector& operator=( const channel_selector& );
+		
+		public:
+			channel_selector() : it_is_ready()
+			{
+			}
+			
+			void notify();
+			
+			void wait();
+	};
+	
+	enum recv_status
+	{
+		Recv_empty,
+		Recv_closed,
+		Recv_ok,
+	};
+	
+	/*
+		A channel buffers up to its capacity of elements in a ring, which
+		starts small and doubles when it's full, up to the capacity.  Each
+		buffered element is a root, since it may be the only reference to a
+		closure whose scope has ended.  With a capacity of zero, it's a rendezvous:  A sender waits until there's a
+		receiver waiting (an attached selector counts as one) and the
+		previous element has been taken.
+	*/
+	
 	class channel_state
 	{
 		private:
@@ -25,22 +71,53 @@ namespace vlib
 			poseven::cond   its_recv_cond;
 			bool            it_is_closed;
 			unsigned        its_recv_count;
-			Value           its_element;
+			
+			std::vector< Value >  its_ring;
+			root_link*            its_links;  // one for each slot in the ring
+			std::size_t           its_capacity;
+			std::size_t           its_head;
+			std::size_t           its_count;
+			
+			std::vector< channel_selector* >  its_selectors;
 			
 			// non-copyable
 			channel_state           ( const channel_state& );
 			channel_state& operator=( const channel_state& );
-		
-		public:
-			channel_state() : it_is_closed(), its_recv_count()
+			
+			bool can_send() const
 			{
+				return its_count < its_capacity  ||  (its_count == 0  &&  its_recv_count > 0);
 			}
 			
+			bool wait_to_send( const poseven::lock& k );
+			
+			void notify_selectors();
+			
+			void grow();
+			
+			void put( const Value& v );
+			
+			Value take();
+		
+		public:
+			channel_state( std::size_t capacity = 0 );
+			
+			~channel_state();
+			
 			void close();
 			
 			bool send( const Value& v );
 			
+			bool send_list( const Value& list );
+			
 			Value recv();
+			
+			Value recv_list( std::size_t n );
+			
+			recv_status try_recv( Value& result );
+			
+			void attach( channel_selector* selector );
+			void detach( channel_selector* selector );
 	};
 	
 }
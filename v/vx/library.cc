@@ -75,7 +75,7 @@ namespace vlib
 		const char* code = expr->left .string().c_str();
 		const char* file = expr->right.string().c_str();
 		
-		const Value result = interpret( code, file, NULL, &eval_error_handler );
+		const Value result = interpret_cached( code, file, &eval_error_handler );
 		
 		if ( Expr* expr = result.expr() )
 		{
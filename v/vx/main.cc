@@ -43,10 +43,12 @@
 #include "empty_signal_handler.hh"
 #include "file_descriptor.hh"
 #include "library.hh"
+#include "parallel.hh"
 #include "posixfs.hh"
 #include "sockets.hh"
 #include "thread.hh"
 #include "thread_state.hh"
+#include "channel/channel.hh"
 #include "channel/metatype.hh"
 
 
@@ -251,6 +253,7 @@ int main( int argc, char** argv )
 	}
 	
 	define( "channel", Channel_Metatype() );
+	define( proc_select );
 	
 	define( fd_vtype      );
 	define( thread_vtype  );
@@ -268,7 +271,10 @@ int main( int argc, char** argv )
 	define( proc_listdir  );
 	define( proc_load     );
 	define( proc_lstat    );
+	define( proc_pfilter  );
 	define( proc_pipe     );
+	define( proc_pmap     );
+	define( proc_preduce  );
 	define( proc_print    );
 	define( proc_read     );
 	define( proc_reader   );
@@ -0,0 +1,360 @@
+/*
+	parallel.cc
+	-----------
+*/
+
+#include "parallel.hh"
+
+// Standard C++
+#include <algorithm>
+#include <vector>
+
+// vlib
+#include "vlib/array-utils.hh"
+#include "vlib/exceptions.hh"
+#include "vlib/function-utils.hh"
+#include "vlib/list-utils.hh"
+#include "vlib/throw.hh"
+#include "vlib/tracker.hh"
+#include "vlib/types.hh"
+#include "vlib/iterators/generic_iterator.hh"
+#include "vlib/iterators/list_builder.hh"
+#include "vlib/types/boolean.hh"
+
+// vx
+#include "thread_pool.hh"
+
+
+namespace vlib
+{
+	
+	/*
+		pmap, pfilter, and preduce split the elements of a container into
+		contiguous chunks and hand them to the thread pool.  The results
+		are joined in the order of the chunks, so pmap and pfilter return
+		the same array as map and filter would.  preduce reduces each chunk
+		separately and then reduces their results, so its function must be
+		associative.  An initial value (`init >- f`) is applied only once.
+		
+		Culls are deferred while the chunks are in progress (see tracker.hh),
+		and each chunk's result is a GC root until it's joined.
+	*/
+	
+	enum parallel_op
+	{
+		Parallel_map,
+		Parallel_filter,
+		Parallel_reduce,
+	};
+	
+	enum chunk_status
+	{
+		Chunk_ok,
+		Chunk_user_exception,
+		Chunk_language_error,
+		Chunk_exception,
+		Chunk_failed,
+	};
+	
+	struct chunk
+	{
+		const Value*  begin;
+		const Value*  end;
+		
+		Value         output;
+		root_link     root;
+		
+		chunk_status  status;
+		Value         error;
+		plus::string  message;
+		source_spec   source;
+		
+		chunk() : status()
+		{
+		}
+	};
+	
+	class chunk_array
+	{
+		private:
+			chunk* its_chunks;
+			
+			// non-copyable
+			chunk_array           ( const chunk_array& );
+			chunk_array& operator=( const chunk_array& );
+		
+		public:
+			chunk_array( std::size_t n ) : its_chunks( new chunk[ n ] )
+			{
+			}
+			
+			~chunk_array()
+			{
+				delete [] its_chunks;
+			}
+			
+			chunk* get() const  { return its_chunks; }
+			
+			chunk& operator[]( std::size_t i )  { return its_chunks[ i ]; }
+	};
+	
+	struct parallel_job
+	{
+		parallel_op   op;
+		const Value*  f;
+		chunk*        chunks;
+	};
+	
+	static
+	Value fold( const Value& f, Value result, const Value* it, const Value* end )
+	{
+		for ( ;  it < end;  ++it )
+		{
+			result = call_function( f, make_list( result, *it ) );
+		}
+		
+		return result;
+	}
+	
+	static
+	void map_chunk( chunk& c, const Value& f )
+	{
+		list_builder result;
+		
+		for ( const Value* it = c.begin;  it < c.end;  ++it )
+		{
+			result.append( call_function( f, *it ) );
+		}
+		
+		c.output = result.move();
+		
+		c.root.link_shared( c.output );
+	}
+	
+	static
+	void filter_chunk( chunk& c, const Value& f )
+	{
+		list_builder result;
+		
+		for ( const Value* it = c.begin;  it < c.end;  ++it )
+		{
+			Value passed = call_function( f, *it );
+			
+			if ( passed.to< Boolean >() )
+			{
+				result.append( *it );
+			}
+		}
+		
+		c.output = result.move();
+		
+		c.root.link_shared( c.output );
+	}
+	
+	static
+	void reduce_chunk( chunk& c, const Value& f )
+	{
+		c.output = fold( f, *c.begin, c.begin + 1, c.end );
+		
+		c.root.link_shared( c.output );
+	}
+	
+	static
+	void run_chunk( void* param, std::size_t i )
+	{
+		const parallel_job& job = *(const parallel_job*) param;
+		
+		chunk& c = job.chunks[ i ];
+		
+		try
+		{
+			switch ( job.op )
+			{
+				case Parallel_map:     map_chunk   ( c, *job.f );  break;
+				case Parallel_filter:  filter_chunk( c, *job.f );  break;
+				case Parallel_reduce:  reduce_chunk( c, *job.f );  break;
+			}
+		}
+		catch ( const user_exception& e )
+		{
+			c.status = Chunk_user_exception;
+			c.error  = e.object;
+			c.source = e.source;
+		}
+		catch ( const language_error& e )
+		{
+			c.status  = Chunk_language_error;
+			c.message = e.text;
+			c.source  = e.source;
+		}
+		catch ( const exception& e )
+		{
+			c.status  = Chunk_exception;
+			c.message = e.message;
+		}
+		catch ( ... )
+		{
+			c.status = Chunk_failed;
+		}
+	}
+	
+	static
+	void rethrow( const chunk& c )
+	{
+		switch ( c.status )
+		{
+			case Chunk_ok:
+				break;
+			
+			case Chunk_user_exception:
+				throw user_exception( c.error, c.source );
+			
+			case Chunk_language_error:
+				throw language_error( c.message, c.source );
+			
+			case Chunk_exception:
+				THROW( c.message );
+			
+			case Chunk_failed:
+				THROW( "unexpected exception in parallel task" );
+		}
+	}
+	
+	static
+	Value run_parallel( parallel_op   op,
+	                    const Value&  container,
+	                    const Value&  f,
+	                    const Value*  initial = NULL )
+	{
+		std::vector< Value > elements;
+		
+		for ( generic_iterator it( container );  it;  )
+		{
+			elements.push_back( it.use() );
+		}
+		
+		const std::size_t n = elements.size();
+		
+		if ( n == 0 )
+		{
+			if ( op != Parallel_reduce )
+			{
+				return empty_array;
+			}
+			
+			return initial ? *initial : empty_list;
+		}
+		
+		// A few chunks per thread, to even out their running times.
+		
+		const std::size_t n_chunks = std::min( n, thread_pool_size() * 4 );
+		
+		chunk_array chunks( n_chunks );
+		
+		const Value* begin = &elements[ 0 ];
+		
+		for ( std::size_t i = 0;  i < n_chunks;  ++i )
+		{
+			chunks[ i ].begin = begin + n *  i      / n_chunks;
+			chunks[ i ].end   = begin + n * (i + 1) / n_chunks;
+		}
+		
+		const parallel_job job = { op, &f, chunks.get() };
+		
+		{
+			gc_deferral deferral;
+			
+			run_tasks( &run_chunk, (void*) &job, n_chunks );
+		}
+		
+		std::vector< Value > outputs( n_chunks );
+		
+		for ( std::size_t i = 0;  i < n_chunks;  ++i )
+		{
+			rethrow( chunks[ i ] );
+			
+			outputs[ i ] = chunks[ i ].output;
+		}
+		
+		if ( op == Parallel_reduce )
+		{
+			const Value* it  = &outputs[ 0 ];
+			const Value* end = it + n_chunks;
+			
+			return initial ? fold( f, *initial, it,     end )
+			               : fold( f, *it,      it + 1, end );
+		}
+		
+		list_builder result;
+		
+		for ( std::size_t i = 0;  i < n_chunks;  ++i )
+		{
+			result.append( outputs[ i ] );
+		}
+		
+		return make_array( result );
+	}
+	
+	static
+	Value v_pmap( const Value& v )
+	{
+		const Value& container = first( v );
+		const Value& f         = rest ( v );
+		
+		if ( ! is_functional( f ) )
+		{
+			THROW( "pmap requires a function" );
+		}
+		
+		return run_parallel( Parallel_map, container, f );
+	}
+	
+	static
+	Value v_pfilter( const Value& v )
+	{
+		const Value& container = first( v );
+		const Value& f         = rest ( v );
+		
+		if ( ! is_functional( f ) )
+		{
+			THROW( "pfilter requires a function" );
+		}
+		
+		return run_parallel( Parallel_filter, container, f );
+	}
+	
+	static
+	Value v_preduce( const Value& v )
+	{
+		const Value& container = first( v );
+		const Value& reducer   = rest ( v );
+		
+		const Value* routine = &reducer;
+		const Value* initial = NULL;
+		
+		if ( Expr* expr = reducer.expr() )
+		{
+			if ( expr->op == Op_forward_init )
+			{
+				initial = &expr->left;
+				routine = &expr->right;
+			}
+			else if ( expr->op == Op_reverse_init )
+			{
+				THROW( "preduce doesn't support reverse folding" );
+			}
+		}
+		
+		if ( ! is_functional( *routine ) )
+		{
+			THROW( "preduce requires a function" );
+		}
+		
+		return run_parallel( Parallel_reduce, container, *routine, initial );
+	}
+	
+	const proc_info proc_pfilter = { "pfilter", &v_pfilter, NULL };
+	const proc_info proc_pmap    = { "pmap",    &v_pmap,    NULL };
+	const proc_info proc_preduce = { "preduce", &v_preduce, NULL };
+	
+}
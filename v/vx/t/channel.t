@@ -0,0 +1,54 @@
+#!/usr/bin/env jtest
+
+$ vx -e 'const c = channel(2); c <== 1; c <== 2; print rep c.recv(2)'
+1 >= '[1, 2]'
+
+%
+
+$ vx -e 'const c = channel(3); c.send(1, 2, 3); c.close(); var s = 0; for x in c do {s += x}; print s'
+1 >= 6
+
+%
+
+$ vx -e 'const c = channel(); const t = thread {var s = 0; for x in c do {s += x}; s}; c.send(1, 2, 3); c.close(); print(*t)'
+1 >= 6
+
+%
+
+$ vx -e 'const a = channel(1); const b = channel(1); b <== 5; print rep select(a, b).value'
+1 >= 5
+
+%
+
+$ vx -e 'const a = channel(); const b = channel(); a.close(); b.close(); print rep select(a, b)'
+1 >= '()'
+
+%
+
+$ vx -e 'const a = channel(); const t = thread {a <== 7; 0}; print rep select(a).value; t.join()'
+1 >= 7
+
+%
+
+$ vx -e 'const c = channel(40); for i in 0 -> 12 do {c <== i}; c.recv(8); for j in 12 -> 28 do {c <== j}; print rep c.recv(40)'
+1 >= '[8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27]'
+
+%
+
+$ vx -e 'const c = channel(4000000000); c.send(1, 2, 3); print rep c.recv(2^70)'
+1 >= '[1, 2, 3]'
+
+%
+
+$ vx -e 'const c = channel(2); c <== 1; try {c.recv(0)} catch {print _}'
+1 >= 'channel recv count must be positive'
+
+%
+
+$ vx -e 'const c = channel(4); def mk { var n = 41; const f = lambda { n + 1 }; c <== f; 0 }; mk(); const g = c.recv(); print g()'
+1 >= 42
+
+%
+
+$ vx -e 'const c = channel(40); def mk { var n = 41; const f = lambda { n + 1 }; for i in 0 -> 20 do {c <== f}; 0 }; mk(); V.tracker.cull(); print rep (c.recv(20) map {_()})'
+1 >= '[42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42]'
@@ -67,3 +67,18 @@ $ vx -e 'print rep eval "const end = str 0; 3 + 4\nend.\nlength"'
 
 $ vx -e 'print rep eval "const end = str 0; 3 + 4\nend.\nNot parsed ` ! @ $"'
 1 >= 7
+
+%
+
+$ vx -e 'const m = "module m; var n = 0; export def bump { ++n }"; const a = eval( m, "m" ); const b = eval( m, "m" ); a.bump(); print (a.bump(), b.bump())'
+1 >= 21
+
+%
+
+$ vx -e 'const __export__ = 3; print (eval( "module m; var __export__ = 5; export const x = __export__", "m" ).x + __export__)'
+1 >= 8
+
+%
+
+$ vx -e 'var s = 0; for i in 0 -> 200 do {s += eval( "export const y = 1", str( "f", i % 70 ) ) + eval( str( "export const y = ", i ), "g" )}; print s'
+1 >= 20100
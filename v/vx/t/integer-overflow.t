@@ -0,0 +1,14 @@
+#!/usr/bin/env jtest
+
+$ vx -e 'const max = 9223372036854775807; print (max + 1, " ", -max - 2)'
+1 >= "9223372036854775808 -9223372036854775809"
+
+%
+
+$ vx -e 'var x = 9223372036854775807; ++x; x *= x; print x'
+1 >= 85070591730234615865843651857942052864
+
+%
+
+$ vx -e 'print (4294967296 * 4294967296, " ", -7 div 2, " ", -7 % 2)'
+1 >= "18446744073709551616 -3 -1"
@@ -0,0 +1,54 @@
+#!/usr/bin/env jtest
+
+$ vx -e 'print rep pmap( [1, 2, 3, 4, 5], {_ * 2} )'
+1 >= '[2, 4, 6, 8, 10]'
+
+%
+
+$ vx -e 'const xs = (0 -> 100) map {_}; print (pmap( xs, {_^2} ) == (xs map {_^2}))'
+1 >= 'true'
+
+%
+
+$ vx -e 'print rep pfilter( (0 -> 20) map {_}, {_ % 3 == 0} )'
+1 >= '[0, 3, 6, 9, 12, 15, 18]'
+
+%
+
+$ vx -e 'print preduce( (1 -> 101) map {_}, lambda (a, b) {a + b} )'
+1 >= 5050
+
+%
+
+$ vx -e 'print (preduce( [2, 3, 4], 1 >- lambda (a, b) {a * b} ), preduce( [], 7 >- lambda (a, b) {a * b} ))'
+1 >= 247
+
+%
+
+$ vx -e 'print (rep pmap( [], {_} ), rep preduce( [], lambda (a, b) {a + b} ))'
+1 >= '[]()'
+
+%
+
+$ vx -e 'const fs = pmap( [1, 2, 3], {var n = _; var g = lambda {if g then {n} else {0}}; g} ); V.tracker.cull(); print rep (fs map {_()})'
+1 >= '[1, 2, 3]'
+
+%
+
+$ vx -e 'try {pmap( [1, 2, 3], {if _ == 2 then {throw "two"}; _} )} catch {print _}'
+1 >= 'two'
+
+%
+
+$ vx -e 'var t = int^[]; for i in 0 -> 1000 do {t <-- i => i * 2}; const u = t; print preduce( pmap( (0 -> 1000) map {_}, {u[_]} ), lambda (a, b) {a + b} )'
+1 >= 999000
+
+%
+
+$ vx -e 'const xs = (0 -> 1000) map {_}; print preduce( pmap( (0 -> 1000) map {_}, {xs[_] + xs.length} ), lambda (a, b) {a + b} )'
+1 >= 1499500
+
+%
+
+$ vx -e 'const a = 1; const b = 2; const c = 3; const d = 4; const e = 5; const f = 6; const g = 7; const h = 8; const k = 10; print preduce( pmap( (0 -> 100) map {_}, {_ * k} ), lambda (a, b) {a + b} )'
+1 >= 49500
@@ -0,0 +1,14 @@
+#!/usr/bin/env jtest
+
+$ vx -e 'var s = "ab"; s <-- "cd"; s <-- 5, 6; s <-- '"'"'x'"'"'; print rep s'
+1 >= '"abcd56x"'
+
+%
+
+$ vx -e 'var s = "ab"; const t = s; s <-- "cd"; print (s, " ", t)'
+1 >= "abcd ab"
+
+%
+
+$ vx -e 'var s = ""; for i in 0 -> 1000 do { s <-- i % 10 }; print (s.length, " ", s[ 997 ])'
+1 >= "1000 7"
@@ -0,0 +1,186 @@
+/*
+	thread_pool.cc
+	--------------
+*/
+
+#include "thread_pool.hh"
+
+// POSIX
+#include <pthread.h>
+#include <unistd.h>
+
+// Standard C++
+#include <algorithm>
+#include <vector>
+
+// poseven
+#include "poseven/types/cond.hh"
+#include "poseven/types/mutex.hh"
+
+
+namespace vlib
+{
+	
+	namespace p7 = poseven;
+	
+	
+	struct batch
+	{
+		task_proc    task;
+		void*        param;
+		std::size_t  n;
+		std::size_t  next;      // the next unclaimed task
+		std::size_t  finished;
+	};
+	
+	class thread_pool
+	{
+		private:
+			p7::mutex  its_mutex;
+			p7::cond   its_work_cond;
+			p7::cond   its_done_cond;
+			
+			std::vector< batch* >  its_queue;  // batches with unclaimed tasks
+			
+			// non-copyable
+			thread_pool           ( const thread_pool& );
+			thread_pool& operator=( const thread_pool& );
+			
+			static void* start( void* param );
+			
+			bool claim( batch* b, std::size_t& i );
+			
+			void perform( batch* b, std::size_t i );  // with its_mutex locked
+		
+		public:
+			thread_pool( std::size_t n_workers );
+			
+			void run( batch& b );
+	};
+	
+	bool thread_pool::claim( batch* b, std::size_t& i )
+	{
+		if ( b->next == b->n )
+		{
+			return false;
+		}
+		
+		i = b->next++;
+		
+		if ( b->next == b->n )
+		{
+			its_queue.erase( std::find( its_queue.begin(), its_queue.end(), b ) );
+		}
+		
+		return true;
+	}
+	
+	void thread_pool::perform( batch* b, std::size_t i )
+	{
+		{
+			p7::unlock u( its_mutex );
+			
+			b->task( b->param, i );
+		}
+		
+		if ( ++b->finished == b->n )
+		{
+			its_done_cond.broadcast();
+		}
+	}
+	
+	void* thread_pool::start( void* param )
+	{
+		thread_pool& pool = *(thread_pool*) param;
+		
+		p7::lock k( pool.its_mutex );
+		
+		while ( true )
+		{
+			while ( pool.its_queue.empty() )
+			{
+				pool.its_work_cond.wait( k );
+			}
+			
+			batch* b = pool.its_queue.front();
+			
+			std::size_t i;
+			
+			pool.claim( b, i );
+			
+			pool.perform( b, i );
+		}
+		
+		return NULL;
+	}
+	
+	thread_pool::thread_pool( std::size_t n_workers )
+	{
+		for ( std::size_t i = 0;  i < n_workers;  ++i )
+		{
+			pthread_t thread;
+			
+			// With fewer workers, submitters do more of the work themselves.
+			
+			if ( pthread_create( &thread, NULL, &start, this ) == 0 )
+			{
+				pthread_detach( thread );
+			}
+		}
+	}
+	
+	void thread_pool::run( batch& b )
+	{
+		p7::lock k( its_mutex );
+		
+		its_queue.push_back( &b );
+		
+		its_work_cond.broadcast();
+		
+		std::size_t i;
+		
+		while ( claim( &b, i ) )
+		{
+			perform( &b, i );
+		}
+		
+		while ( b.finished < b.n )
+		{
+			its_done_cond.wait( k );
+		}
+	}
+	
+	std::size_t thread_pool_size()
+	{
+		static const long n = sysconf( _SC_NPROCESSORS_ONLN );
+		
+		return n > 1 ? n : 1;
+	}
+	
+	static
+	thread_pool& the_thread_pool()
+	{
+		/*
+			The workers never exit, so the pool is never destroyed (which
+			would otherwise happen during static destruction, with workers
+			still waiting on its condition variable).
+		*/
+		
+		static thread_pool* pool = new thread_pool( thread_pool_size() - 1 );
+		
+		return *pool;
+	}
+	
+	void run_tasks( task_proc task, void* param, std::size_t n )
+	{
+		if ( n == 0 )
+		{
+			return;
+		}
+		
+		batch b = { task, param, n, 0, 0 };
+		
+		the_thread_pool().run( b );
+	}
+	
+}
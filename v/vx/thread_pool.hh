@@ -0,0 +1,34 @@
+/*
+	thread_pool.hh
+	--------------
+*/
+
+#ifndef THREADPOOL_HH
+#define THREADPOOL_HH
+
+// Standard C++
+#include <cstddef>
+
+
+namespace vlib
+{
+	
+	/*
+		The thread pool has a fixed set of worker threads, started on first
+		use:  one fewer than the number of online processors, because the
+		thread that submits a batch of tasks works on it too.  That also
+		guarantees progress for a batch submitted from within a task, even
+		when every worker is busy.
+		
+		A task must not throw.
+	*/
+	
+	typedef void (*task_proc)( void* param, std::size_t i );
+	
+	void run_tasks( task_proc task, void* param, std::size_t n );
+	
+	std::size_t thread_pool_size();  // including the submitting thread
+	
+}
+
+#endif
@@ -52,7 +52,7 @@ namespace vlib
 	static
 	void add_joinable_thread( thread_state* t )
 	{
-		add_root( t->function() );
+		t->link_root();
 		
 		p7::lock k( joinable_threads_mutex );
 		
@@ -62,7 +62,7 @@ namespace vlib
 	static
 	void del_joinable_thread( thread_state* t )
 	{
-		del_root( t->function() );
+		t->unlink_root();
 		
 		p7::lock k( joinable_threads_mutex );
 		
@@ -10,6 +10,7 @@
 #include "poseven/types/thread.hh"
 
 // vlib
+#include "vlib/tracker.hh"
 #include "vlib/value.hh"
 
 
@@ -37,6 +38,7 @@ namespace vlib
 		private:
 			poseven::thread         its_thread;
 			thread_parameter_block  its_pb;
+			root_link               its_root;
 			
 			// non-copyable
 			thread_state           ( const thread_state& );
@@ -58,6 +60,14 @@ namespace vlib
 			
 			const Value& operator*();
 			
+			/*
+				A thread's function is a root for as long as the thread is
+				joinable, and may be released from any thread.
+			*/
+			
+			void link_root()    { its_root.link_shared( its_pb.f ); }
+			void unlink_root()  { its_root.unlink();                }
+			
 			bool terminated() const  { return its_thread.terminated(); }
 			
 			const Value& function() const  { return its_pb.f;      }
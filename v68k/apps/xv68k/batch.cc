@@ -0,0 +1,285 @@
+/*
+	batch.cc
+	--------
+*/
+
+#include "batch.hh"
+
+// POSIX
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Standard C
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// gear
+#include "gear/inscribe_decimal.hh"
+
+// v68k-time
+#include "v68k-time/clock.hh"
+
+
+#pragma exceptions off
+
+
+/*
+	Each program runs in its own child process, forked from an xv68k that
+	has already installed its modules.  The child's copy of the address
+	space is the per-instance state:  low memory, alloc pages, Mac globals
+	and the screen all start out as the parent left them, and whatever the
+	program does to them is discarded when it exits.
+	
+	The child's instruction count comes back through a pipe, written by
+	report_batch_instruction_count() from xv68k's atexit handler.
+	
+	One line is written to stdout per program, in order of completion:
+	
+		pass|fail	<exit status or signal>	<instructions>	<seconds>	<path>
+	
+	followed by a summary line.  The programs' own stdout is discarded.
+*/
+
+struct batch_job
+{
+	pid_t        pid;
+	int          fd;
+	uint64_t     start;
+	const char*  path;
+};
+
+static int batch_fd = -1;
+
+void report_batch_instruction_count( unsigned long n )
+{
+	if ( batch_fd >= 0 )
+	{
+		write( batch_fd, &n, sizeof n );
+	}
+}
+
+static
+void write_str( const char* s )
+{
+	write( STDOUT_FILENO, s, strlen( s ) );
+}
+
+static
+bool report( const batch_job& job, int wait_status, uint64_t end )
+{
+	using gear::inscribe_unsigned_decimal;
+	
+	const bool passed = WIFEXITED( wait_status )  &&
+	                    WEXITSTATUS( wait_status ) == 0;
+	
+	write_str( passed ? "pass\t" : "fail\t" );
+	
+	if ( WIFEXITED( wait_status ) )
+	{
+		write_str( inscribe_unsigned_decimal( WEXITSTATUS( wait_status ) ) );
+	}
+	else
+	{
+		write_str( "signal " );
+		write_str( inscribe_unsigned_decimal( WTERMSIG( wait_status ) ) );
+	}
+	
+	write_str( "\t" );
+	
+	unsigned long n_instructions;
+	
+	const ssize_t size = sizeof n_instructions;
+	
+	if ( read( job.fd, &n_instructions, size ) == size )
+	{
+		write_str( inscribe_unsigned_decimal( n_instructions ) );
+	}
+	else
+	{
+		write_str( "-" );  // killed before its atexit handler could run
+	}
+	
+	const uint64_t usecs = end - job.start;
+	
+	char fraction[] = ".000000";
+	
+	unsigned long remainder = usecs % 1000000;
+	
+	for ( char* p = fraction + 6;  p > fraction;  --p )
+	{
+		*p = '0' + remainder % 10;
+		
+		remainder /= 10;
+	}
+	
+	write_str( "\t" );
+	write_str( inscribe_unsigned_decimal( usecs / 1000000 ) );
+	write_str( fraction );
+	write_str( "\t" );
+	write_str( job.path );
+	write_str( "\n" );
+	
+	return passed;
+}
+
+static
+bool launch( batch_job& job, const char* path, batch_runner run, void* context )
+{
+	int fds[ 2 ];
+	
+	if ( pipe( fds ) < 0 )
+	{
+		return false;
+	}
+	
+	job.path  = path;
+	job.start = v68k::time::microsecond_clock();
+	
+	job.pid = fork();
+	
+	if ( job.pid < 0 )
+	{
+		close( fds[ 0 ] );
+		close( fds[ 1 ] );
+		
+		return false;
+	}
+	
+	if ( job.pid == 0 )
+	{
+		close( fds[ 0 ] );
+		
+		batch_fd = fds[ 1 ];
+		
+		int null = open( "/dev/null", O_WRONLY );
+		
+		if ( null >= 0 )
+		{
+			dup2( null, STDOUT_FILENO );
+			close( null );
+		}
+		
+		char* argv[] = { (char*) path, 0 };  // NULL
+		
+		exit( run( context, argv ) );
+	}
+	
+	close( fds[ 1 ] );
+	
+	fcntl( fds[ 0 ], F_SETFD, FD_CLOEXEC );
+	
+	job.fd = fds[ 0 ];
+	
+	return true;
+}
+
+static
+int abandon( batch_job* jobs, unsigned n_running )
+{
+	// Kill and reap the running children, and release everything.
+	
+	const int saved_errno = errno;
+	
+	for ( unsigned i = 0;  i < n_running;  ++i )
+	{
+		kill( jobs[ i ].pid, SIGKILL );
+	}
+	
+	for ( unsigned i = 0;  i < n_running;  ++i )
+	{
+		while ( waitpid( jobs[ i ].pid, NULL, 0 ) < 0  &&  errno == EINTR )
+		{
+			continue;
+		}
+		
+		close( jobs[ i ].fd );
+	}
+	
+	free( jobs );
+	
+	errno = saved_errno;
+	
+	return -1;
+}
+
+int run_batch( unsigned      n_jobs,
+               char* const*  programs,
+               batch_runner  run,
+               void*         context )
+{
+	batch_job* jobs = (batch_job*) calloc( n_jobs, sizeof (batch_job) );
+	
+	if ( jobs == 0 )  // NULL
+	{
+		errno = ENOMEM;
+		
+		return -1;
+	}
+	
+	unsigned n_running = 0;
+	unsigned n_passed  = 0;
+	unsigned n_failed  = 0;
+	
+	while ( *programs != 0  ||  n_running > 0 )
+	{
+		while ( *programs != 0  &&  n_running < n_jobs )
+		{
+			if ( ! launch( jobs[ n_running ], *programs, run, context ) )
+			{
+				return abandon( jobs, n_running );
+			}
+			
+			++programs;
+			++n_running;
+		}
+		
+		int wait_status;
+		
+		pid_t pid;
+		
+		while ( (pid = wait( &wait_status )) < 0  &&  errno == EINTR )
+		{
+			continue;
+		}
+		
+		if ( pid < 0 )
+		{
+			return abandon( jobs, n_running );
+		}
+		
+		const uint64_t end = v68k::time::microsecond_clock();
+		
+		for ( unsigned i = 0;  i < n_running;  ++i )
+		{
+			batch_job& job = jobs[ i ];
+			
+			if ( job.pid == pid )
+			{
+				const bool passed = report( job, wait_status, end );
+				
+				close( job.fd );
+				
+				++(passed ? n_passed : n_failed);
+				
+				job = jobs[ --n_running ];
+				
+				break;
+			}
+		}
+	}
+	
+	free( jobs );
+	
+	using gear::inscribe_unsigned_decimal;
+	
+	write_str( "# " );
+	write_str( inscribe_unsigned_decimal( n_passed ) );
+	write_str( " passed, " );
+	write_str( inscribe_unsigned_decimal( n_failed ) );
+	write_str( " failed\n" );
+	
+	return n_failed;
+}
@@ -0,0 +1,25 @@
+/*
+	batch.hh
+	--------
+*/
+
+#ifndef BATCH_HH
+#define BATCH_HH
+
+
+/*
+	Runs each program in its own process, up to n_jobs at a time, and
+	reports the results on stdout.  Returns the number of programs that
+	failed, or -1 (with errno set) if a process couldn't be started.
+*/
+
+typedef int (*batch_runner)( void* context, char* const* argv );
+
+int run_batch( unsigned      n_jobs,
+               char* const*  programs,
+               batch_runner  run,
+               void*         context );
+
+void report_batch_instruction_count( unsigned long n );
+
+#endif
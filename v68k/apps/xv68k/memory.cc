@@ -92,7 +92,7 @@ uint8_t* translate_with_diagnostic( uint32_t               addr,
 memory_manager::memory_manager( uint8_t*  low_mem_base,
                                 uint32_t  low_mem_size )
 :
-	v68k::memory( &translate_with_diagnostic )
+	v68k::memory( &translate_with_diagnostic, &memory_manager::flat_page )
 {
 	low_memory_base = low_mem_base;
 	low_memory_size = low_mem_size;
@@ -131,3 +131,40 @@ uint8_t* memory_manager::translate( uint32_t               addr,
 	
 	return v68k::callout::translate( addr, length, fc, access );
 }
+
+uint8_t* memory_manager::flat_page( uint32_t               page_addr,
+                                    v68k::function_code_t  fc,
+                                    v68k::memory_access_t  access )
+{
+	const uint32_t page_size = v68k::memory::page_size;
+	
+	if ( page_addr >= v68k::alloc::start  &&  page_addr < v68k::alloc::limit )
+	{
+		return v68k::alloc::translate( page_addr, page_size, fc, access );
+	}
+	
+	/*
+		The first page holds the system vectors, the trap tables, and the
+		Mac low memory globals, which all need special handling.  The screen
+		needs an update after writes, and callouts aren't memory at all.
+	*/
+	
+	if ( page_addr == 0 )
+	{
+		return 0;  // NULL
+	}
+	
+	if ( page_addr >= low_memory_size  ||  low_memory_size - page_addr < page_size )
+	{
+		return 0;  // NULL
+	}
+	
+	const uint32_t screen_size = v68k::screen::the_screen_size;
+	
+	if ( page_addr + page_size > screen_addr  &&  page_addr < screen_addr + screen_size )
+	{
+		return 0;  // NULL
+	}
+	
+	return low_memory_base + page_addr;
+}
@@ -21,6 +21,11 @@ class memory_manager : public v68k::memory
 		                    uint32_t               length,
 		                    v68k::function_code_t  fc,
 		                    v68k::memory_access_t  access );
+		
+		static
+		uint8_t* flat_page( uint32_t               page_addr,
+		                    v68k::function_code_t  fc,
+		                    v68k::memory_access_t  access );
 };
 
 #endif
@@ -0,0 +1,241 @@
+/*
+	native_traps.cc
+	---------------
+*/
+
+#include "native_traps.hh"
+
+// POSIX
+#include <unistd.h>
+
+// Standard C
+#include <string.h>
+
+// gear
+#include "gear/hexadecimal.hh"
+#include "gear/inscribe_decimal.hh"
+
+// v68k
+#include "v68k/endian.hh"
+
+// v68k-callouts
+#include "callout/bridge.hh"
+#include "callout/native_traps.hh"
+
+
+#pragma exceptions off
+
+
+#define STR_LEN( s )  "" s, (sizeof s - 1)
+
+
+using v68k::callout::native_trap;
+
+
+const uint32_t tb_trap_table_address = 3072;
+
+const int max_enabled = 16;
+const int max_pending = 16;
+
+/*
+	In checking mode, the 68K implementations are left installed, and each
+	call is compared against the host implementation:  On entry to the 68K
+	routine we compute the expected result from the parameters on the stack,
+	and when it returns to its caller (with the parameters popped) we compare
+	the result it left against the expectation.
+*/
+
+struct enabled_trap
+{
+	const native_trap*  trap;
+	uint32_t            address;  // of the 68K implementation
+};
+
+struct pending_check
+{
+	const native_trap*  trap;
+	uint32_t            return_address;
+	uint32_t            result_address;
+	uint32_t            expected;
+	uint32_t            params[ 4 ];
+};
+
+static enabled_trap  enabled_traps[ max_enabled ];
+static pending_check pending_checks[ max_pending ];
+
+static int n_enabled;
+static int n_pending;
+
+static unsigned long n_checked;
+static unsigned long n_mismatched;
+
+
+bool enable_native_trap( const char* name )
+{
+	const native_trap* trap = v68k::callout::find_native_trap( name );
+	
+	if ( trap == NULL  ||  n_enabled == max_enabled )
+	{
+		return false;
+	}
+	
+	enabled_traps[ n_enabled++ ].trap = trap;
+	
+	return true;
+}
+
+void install_native_traps( uint8_t* mem, bool checking )
+{
+	using v68k::big_longword;
+	using v68k::longword_from_big;
+	using v68k::callout::callout_address;
+	
+	uint32_t* tb_traps = (uint32_t*) &mem[ tb_trap_table_address ];
+	
+	for ( int i = 0;  i < n_enabled;  ++i )
+	{
+		enabled_trap& enabled = enabled_traps[ i ];
+		
+		uint32_t& entry = tb_traps[ enabled.trap->trap_word & 0x3FF ];
+		
+		enabled.address = longword_from_big( entry );
+		
+		if ( ! checking )
+		{
+			entry = big_longword( callout_address( enabled.trap->callout ) );
+		}
+	}
+}
+
+static
+void write_hex( uint32_t x, int n_digits )
+{
+	char buffer[ 8 ];
+	
+	gear::inscribe_n_HEX_digits( buffer, x, n_digits );
+	
+	write( STDERR_FILENO, buffer, n_digits );
+}
+
+static
+void report_mismatch( const pending_check& check, uint32_t actual )
+{
+	const native_trap& trap = *check.trap;
+	
+	const int result_digits = trap.result_size * 2;
+	
+	write( STDERR_FILENO, STR_LEN( "xv68k: native " ) );
+	write( STDERR_FILENO, trap.name, strlen( trap.name ) );
+	write( STDERR_FILENO, STR_LEN( "(" ) );
+	
+	for ( const char* p = trap.param_sizes;  *p != '\0';  ++p )
+	{
+		if ( p != trap.param_sizes )
+		{
+			write( STDERR_FILENO, STR_LEN( ", " ) );
+		}
+		
+		write( STDERR_FILENO, STR_LEN( "$" ) );
+		write_hex( check.params[ p - trap.param_sizes ], *p == 'L' ? 8 : 4 );
+	}
+	
+	write( STDERR_FILENO, STR_LEN( ") = $" ) );
+	write_hex( check.expected, result_digits );
+	write( STDERR_FILENO, STR_LEN( ", but 68K = $" ) );
+	write_hex( actual, result_digits );
+	write( STDERR_FILENO, STR_LEN( "\n" ) );
+}
+
+static
+void check_return( v68k::emulator& emu, const pending_check& check )
+{
+	const native_trap& trap = *check.trap;
+	
+	uint32_t actual;
+	
+	bool ok;
+	
+	if ( trap.result_size == 4 )
+	{
+		ok = emu.mem.get_long( check.result_address, actual, emu.data_space() );
+	}
+	else
+	{
+		uint16_t word;
+		
+		ok = emu.mem.get_word( check.result_address, word, emu.data_space() );
+		
+		actual = word;
+	}
+	
+	++n_checked;
+	
+	if ( ! ok  ||  actual != check.expected )
+	{
+		++n_mismatched;
+		
+		report_mismatch( check, actual );
+	}
+}
+
+void check_native_traps( v68k::emulator& emu )
+{
+	const uint32_t pc = emu.pc();
+	const uint32_t sp = emu.a(7);
+	
+	if ( n_pending > 0 )
+	{
+		const pending_check& check = pending_checks[ n_pending - 1 ];
+		
+		if ( pc == check.return_address  &&  sp == check.result_address )
+		{
+			check_return( emu, check );
+			
+			--n_pending;
+		}
+	}
+	
+	for ( int i = 0;  i < n_enabled;  ++i )
+	{
+		const enabled_trap& enabled = enabled_traps[ i ];
+		
+		if ( pc == enabled.address  &&  n_pending < max_pending )
+		{
+			const native_trap& trap = *enabled.trap;
+			
+			pending_check& check = pending_checks[ n_pending ];
+			
+			if ( ! emu.mem.get_long( sp, check.return_address, emu.data_space() ) )
+			{
+				return;
+			}
+			
+			if ( ! v68k::callout::get_params( emu, trap, sp, check.params ) )
+			{
+				return;
+			}
+			
+			check.trap           = &trap;
+			check.result_address = sp + 4 + params_size( trap );
+			check.expected       = trap.compute( check.params );
+			
+			++n_pending;
+			
+			return;
+		}
+	}
+}
+
+void report_native_trap_checks()
+{
+	char* checked = gear::inscribe_unsigned_decimal( n_checked );
+	
+	write( STDERR_FILENO, STR_LEN( "### Native trap calls checked: " ) );
+	write( STDERR_FILENO, checked, strlen( checked ) );
+	
+	char* mismatched = gear::inscribe_unsigned_decimal( n_mismatched );
+	
+	write( STDERR_FILENO, STR_LEN( ", mismatched: " ) );
+	write( STDERR_FILENO, mismatched, strlen( mismatched ) );
+	write( STDERR_FILENO, STR_LEN( "\n" ) );
+}
@@ -0,0 +1,21 @@
+/*
+	native_traps.hh
+	---------------
+*/
+
+#ifndef NATIVETRAPS_HH
+#define NATIVETRAPS_HH
+
+// v68k
+#include "v68k/emulator.hh"
+
+
+bool enable_native_trap( const char* name );
+
+void install_native_traps( uint8_t* mem, bool checking );
+
+void check_native_traps( v68k::emulator& emu );
+
+void report_native_trap_checks();
+
+#endif
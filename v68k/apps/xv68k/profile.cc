@@ -0,0 +1,220 @@
+/*
+	profile.cc
+	----------
+*/
+
+#include "profile.hh"
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+// Standard C
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// gear
+#include "gear/hexadecimal.hh"
+#include "gear/inscribe_decimal.hh"
+
+
+#pragma exceptions off
+
+
+/*
+	Profile file format
+	-------------------
+	
+	One record per line, fields separated by tabs:
+	
+		instructions	<total count>
+		line	<opcode's top nibble, 1 hex digit>	<count>
+		opcode	<opcode, 4 hex digits>	<count>
+		trap	<A-line trap word, 4 hex digits>	<count>
+		pc	<address, 8 hex digits>	<count>
+		pc-overflow	<count of hits at addresses not tracked>
+	
+	Only nonzero counts are listed.  Records of each kind are in ascending
+	order of their second field, except pc, which is unordered.
+*/
+
+struct pc_count
+{
+	uint32_t       pc;
+	unsigned long  count;
+};
+
+const uint32_t n_pc_slots = 1 << 16;
+
+static int profile_fd = -1;
+
+/*
+	A forked child (as in --batch) inherits profile_fd and the atexit
+	handler, but only the process that opened the profile writes it.
+*/
+
+static pid_t profile_owner;
+
+static unsigned long n_profiled;
+static unsigned long n_pc_overflow;
+
+static unsigned long* opcode_counts;  // 64K
+static unsigned long* trap_counts;    // 4K
+static pc_count*      pc_counts;      // n_pc_slots
+
+static inline
+uint32_t pc_slot( uint32_t pc )
+{
+	return (pc >> 1) * 0x9E3779B1u >> 16;  // Fibonacci hash, 16 bits
+}
+
+int open_profile( const char* path )
+{
+	profile_fd = open( path, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+	
+	if ( profile_fd < 0 )
+	{
+		return errno;
+	}
+	
+	profile_owner = getpid();
+	
+	opcode_counts = (unsigned long*) calloc( 0x10000, sizeof (unsigned long) );
+	trap_counts   = (unsigned long*) calloc( 0x1000,  sizeof (unsigned long) );
+	pc_counts     = (pc_count*)      calloc( n_pc_slots, sizeof (pc_count) );
+	
+	if ( ! opcode_counts  ||  ! trap_counts  ||  ! pc_counts )
+	{
+		return ENOMEM;
+	}
+	
+	return 0;
+}
+
+void profile_instruction( uint32_t pc, uint16_t opcode )
+{
+	++n_profiled;
+	
+	++opcode_counts[ opcode ];
+	
+	if ( (opcode & 0xF000) == 0xA000 )
+	{
+		++trap_counts[ opcode & 0x0FFF ];
+	}
+	
+	// Open addressing with linear probing; a zero count marks an empty slot.
+	
+	uint32_t i = pc_slot( pc );
+	
+	for ( uint32_t n = 0;  n < n_pc_slots;  ++n )
+	{
+		pc_count& slot = pc_counts[ i ];
+		
+		if ( slot.pc == pc )
+		{
+			++slot.count;
+			return;
+		}
+		
+		if ( slot.count == 0 )
+		{
+			slot.pc    = pc;
+			slot.count = 1;
+			return;
+		}
+		
+		i = (i + 1) & (n_pc_slots - 1);
+	}
+	
+	++n_pc_overflow;
+}
+
+static
+void write_record( const char* kind, unsigned long key, int key_digits, unsigned long count )
+{
+	char buffer[ 64 ];
+	
+	char* p = buffer;
+	
+	const size_t kind_len = strlen( kind );
+	
+	memcpy( p, kind, kind_len );
+	
+	p += kind_len;
+	
+	if ( key_digits )
+	{
+		*p++ = '\t';
+		
+		gear::inscribe_n_HEX_digits( p, key, key_digits );
+		
+		p += key_digits;
+	}
+	
+	*p++ = '\t';
+	
+	p = gear::inscribe_unsigned_r< 10 >( count, p );
+	
+	*p++ = '\n';
+	
+	write( profile_fd, buffer, p - buffer );
+}
+
+void write_profile()
+{
+	if ( profile_fd < 0  ||  getpid() != profile_owner )
+	{
+		return;
+	}
+	
+	write_record( "instructions", 0, 0, n_profiled );
+	
+	unsigned long line_counts[ 16 ] = { 0 };
+	
+	for ( unsigned i = 0;  i < 0x10000;  ++i )
+	{
+		line_counts[ i >> 12 ] += opcode_counts[ i ];
+	}
+	
+	for ( unsigned i = 0;  i < 16;  ++i )
+	{
+		if ( line_counts[ i ] )
+		{
+			write_record( "line", i, 1, line_counts[ i ] );
+		}
+	}
+	
+	for ( unsigned i = 0;  i < 0x10000;  ++i )
+	{
+		if ( opcode_counts[ i ] )
+		{
+			write_record( "opcode", i, 4, opcode_counts[ i ] );
+		}
+	}
+	
+	for ( unsigned i = 0;  i < 0x1000;  ++i )
+	{
+		if ( trap_counts[ i ] )
+		{
+			write_record( "trap", 0xA000 | i, 4, trap_counts[ i ] );
+		}
+	}
+	
+	for ( unsigned i = 0;  i < n_pc_slots;  ++i )
+	{
+		if ( pc_counts[ i ].count )
+		{
+			write_record( "pc", pc_counts[ i ].pc, 8, pc_counts[ i ].count );
+		}
+	}
+	
+	if ( n_pc_overflow )
+	{
+		write_record( "pc-overflow", 0, 0, n_pc_overflow );
+	}
+	
+	close( profile_fd );
+	
+	profile_fd = -1;
+}
@@ -0,0 +1,19 @@
+/*
+	profile.hh
+	----------
+*/
+
+#ifndef PROFILE_HH
+#define PROFILE_HH
+
+// Standard C
+#include <stdint.h>
+
+
+int open_profile( const char* path );
+
+void profile_instruction( uint32_t pc, uint16_t opcode );
+
+void write_profile();
+
+#endif
@@ -0,0 +1,342 @@
+/*
+	snapshot.cc
+	-----------
+*/
+
+#include "snapshot.hh"
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Standard C
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// v68k-alloc
+#include "v68k-alloc/memory.hh"
+
+// v68k-callouts
+#include "callout/bridge.hh"
+
+// v68k-mac
+#include "v68k-mac/memory.hh"
+
+// v68k-screen
+#include "screen/storage.hh"
+
+
+#pragma exceptions off
+
+
+/*
+	Snapshot file format
+	--------------------
+	
+	A snapshot is only meaningful to the xv68k binary that wrote it, since
+	the trap tables hold callout addresses and everything is in host order.
+	The header records a fingerprint of the callout table, and a snapshot
+	whose fingerprint doesn't match the running binary's is rejected.
+	
+		header
+		low memory (mem_size bytes, including vectors and trap tables)
+		Mac low memory globals (globals_size bytes)
+		screen memory (screen_size bytes, or none)
+		n_blocks * { block header, n_pages * 64K bytes }
+	
+	Blocks are runs of alloc pages sharing one host allocation, so that each
+	one can be restored into a single malloc()'d buffer and later freed by
+	the dealloc callout as usual.
+*/
+
+static const char snapshot_magic[ 8 ] = { 'x', 'v', '6', '8', 'k', 'S', 'S', '2' };
+
+struct snapshot_header
+{
+	char      magic[ 8 ];
+	uint32_t  callouts;  // callout_fingerprint()
+	uint32_t  mem_size;
+	uint32_t  globals_size;
+	uint32_t  screen_size;
+	uint32_t  n_blocks;
+	uint32_t  regs[ v68k::n_registers ];
+	uint32_t  sr;
+};
+
+struct block_header
+{
+	uint32_t  addr;
+	uint32_t  n_pages;
+};
+
+static
+bool write_all( int fd, const void* data, size_t size )
+{
+	const char* p = (const char*) data;
+	
+	while ( size > 0 )
+	{
+		ssize_t n_written = write( fd, p, size );
+		
+		if ( n_written < 0 )
+		{
+			return false;
+		}
+		
+		p    += n_written;
+		size -= n_written;
+	}
+	
+	return true;
+}
+
+static
+bool write_snapshot( int                            fd,
+                     const v68k::processor_state&   s,
+                     const uint8_t*                 mem,
+                     uint32_t                       mem_size )
+{
+	using v68k::alloc::next_block;
+	using v68k::alloc::page_size;
+	
+	using v68k::screen::the_screen_buffer;
+	using v68k::screen::the_screen_size;
+	
+	uint32_t globals_size;
+	
+	const uint8_t* globals = v68k::mac::globals_storage( &globals_size );
+	
+	const uint32_t screen_size = the_screen_buffer ? the_screen_size : 0;
+	
+	snapshot_header header = { 0 };
+	
+	memcpy( header.magic, snapshot_magic, sizeof snapshot_magic );
+	
+	header.callouts     = v68k::callout::callout_fingerprint();
+	header.mem_size     = mem_size;
+	header.globals_size = globals_size;
+	header.screen_size  = screen_size;
+	
+	memcpy( header.regs, s.regs, sizeof header.regs );
+	
+	header.sr = s.get_SR();
+	
+	uint32_t n_pages;
+	void*    alloc;
+	
+	for ( uint32_t addr = 0;  (addr = next_block( addr, &n_pages, &alloc ));  )
+	{
+		++header.n_blocks;
+		
+		addr += n_pages * page_size;
+	}
+	
+	if ( ! write_all( fd, &header,  sizeof header )  ||
+	     ! write_all( fd, mem,      mem_size       )  ||
+	     ! write_all( fd, globals,  globals_size   )  ||
+	     ! write_all( fd, the_screen_buffer, screen_size ) )
+	{
+		return false;
+	}
+	
+	for ( uint32_t addr = 0;  (addr = next_block( addr, &n_pages, &alloc ));  )
+	{
+		const block_header block = { addr, n_pages };
+		
+		if ( ! write_all( fd, &block, sizeof block )  ||
+		     ! write_all( fd, alloc, n_pages * page_size ) )
+		{
+			return false;
+		}
+		
+		addr += n_pages * page_size;
+	}
+	
+	return true;
+}
+
+int save_snapshot( const char*                    path,
+                   const v68k::processor_state&   s,
+                   const uint8_t*                 mem,
+                   uint32_t                       mem_size )
+{
+	int fd = open( path, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+	
+	if ( fd < 0 )
+	{
+		return errno;
+	}
+	
+	int err = write_snapshot( fd, s, mem, mem_size ) ? 0 : errno;
+	
+	if ( close( fd ) < 0  &&  err == 0 )
+	{
+		err = errno;
+	}
+	
+	return err;
+}
+
+static
+int restore_snapshot( const uint8_t*           p,
+                      size_t                   size,
+                      v68k::processor_state&   s,
+                      uint8_t*                 mem,
+                      uint32_t                 mem_size )
+{
+	using v68k::alloc::page_size;
+	
+	using v68k::screen::the_screen_buffer;
+	using v68k::screen::the_screen_size;
+	
+	const uint8_t* end = p + size;
+	
+	uint32_t globals_size;
+	
+	uint8_t* globals = v68k::mac::globals_storage( &globals_size );
+	
+	snapshot_header header;
+	
+	if ( size < sizeof header )
+	{
+		return EINVAL;
+	}
+	
+	memcpy( &header, p, sizeof header );
+	
+	p += sizeof header;
+	
+	if ( memcmp( header.magic, snapshot_magic, sizeof snapshot_magic ) != 0  ||
+	     header.callouts     != v68k::callout::callout_fingerprint()         ||
+	     header.mem_size     != mem_size                                     ||
+	     header.globals_size != globals_size )
+	{
+		return EINVAL;
+	}
+	
+	const size_t fixed_size = mem_size + globals_size + header.screen_size;
+	
+	if ( (size_t) (end - p) < fixed_size )
+	{
+		return EINVAL;
+	}
+	
+	memcpy( mem, p, mem_size );
+	
+	p += mem_size;
+	
+	memcpy( globals, p, globals_size );
+	
+	p += globals_size;
+	
+	/*
+		The screen is output only, so a snapshot taken with a different (or
+		no) screen configuration can still be restored -- it just doesn't
+		repaint.
+	*/
+	
+	if ( the_screen_buffer  &&  header.screen_size == the_screen_size )
+	{
+		memcpy( the_screen_buffer, p, the_screen_size );
+	}
+	
+	p += header.screen_size;
+	
+	for ( uint32_t i = 0;  i < header.n_blocks;  ++i )
+	{
+		block_header block;
+		
+		if ( (size_t) (end - p) < sizeof block )
+		{
+			return EINVAL;
+		}
+		
+		memcpy( &block, p, sizeof block );
+		
+		p += sizeof block;
+		
+		const size_t block_size = (size_t) block.n_pages * page_size;
+		
+		if ( (size_t) (end - p) < block_size )
+		{
+			return EINVAL;
+		}
+		
+		void* alloc = malloc( block_size );
+		
+		if ( alloc == NULL )
+		{
+			return ENOMEM;
+		}
+		
+		memcpy( alloc, p, block_size );
+		
+		if ( ! v68k::alloc::restore_block( block.addr, block.n_pages, alloc ) )
+		{
+			free( alloc );
+			
+			return EINVAL;
+		}
+		
+		p += block_size;
+	}
+	
+	memcpy( s.regs, header.regs, sizeof s.regs );
+	
+	s.set_SR( header.sr );
+	
+	return 0;
+}
+
+int load_snapshot( const char*               path,
+                   v68k::processor_state&    s,
+                   uint8_t*                  mem,
+                   uint32_t                  mem_size )
+{
+	int fd = open( path, O_RDONLY );
+	
+	if ( fd < 0 )
+	{
+		return errno;
+	}
+	
+	struct stat st;
+	
+	void* addr = MAP_FAILED;
+	
+	int err = 0;
+	
+	if ( fstat( fd, &st ) < 0 )
+	{
+		err = errno;
+	}
+	else if ( st.st_size == 0 )
+	{
+		err = EINVAL;
+	}
+	else
+	{
+		addr = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		
+		if ( addr == MAP_FAILED )
+		{
+			err = errno;
+		}
+	}
+	
+	close( fd );
+	
+	if ( err )
+	{
+		return err;
+	}
+	
+	err = restore_snapshot( (const uint8_t*) addr, st.st_size, s, mem, mem_size );
+	
+	munmap( addr, st.st_size );
+	
+	return err;
+}
@@ -0,0 +1,26 @@
+/*
+	snapshot.hh
+	-----------
+*/
+
+#ifndef SNAPSHOT_HH
+#define SNAPSHOT_HH
+
+// Standard C
+#include <stdint.h>
+
+// v68k
+#include "v68k/state.hh"
+
+
+int save_snapshot( const char*                    path,
+                   const v68k::processor_state&   s,
+                   const uint8_t*                 mem,
+                   uint32_t                       mem_size );
+
+int load_snapshot( const char*               path,
+                   v68k::processor_state&    s,
+                   uint8_t*                  mem,
+                   uint32_t                  mem_size );
+
+#endif
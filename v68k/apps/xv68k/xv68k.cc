@@ -54,10 +54,14 @@
 #include "syscall/handler.hh"
 
 // xv68k
+#include "batch.hh"
 #include "diagnostics.hh"
 #include "memory.hh"
 #include "native.hh"
+#include "native_traps.hh"
+#include "profile.hh"
 #include "screen.hh"
+#include "snapshot.hh"
 
 
 #pragma exceptions off
@@ -78,12 +82,21 @@ using v68k::callout::microseconds;
 using v68k::screen::ignore_screen_locks;
 
 static bool turbo;
+static bool blocks;
 static bool polling;
 static bool tracing;
 static bool verbose;
+static bool profiling;
+static bool checking_native_traps;
 static bool has_screen;
 
+static unsigned batch_jobs;
+
+static const char* snapshot_path;
+static const char* save_snapshot_path;
+
 static unsigned long n_instructions;
+static uint64_t      n_cycles;
 
 struct module_spec
 {
@@ -99,6 +112,7 @@ static module_spec* module_specs;
 enum
 {
 	Opt_authorized = 'A',
+	Opt_batch      = 'B',
 	Opt_poll       = 'P',
 	Opt_supervisor = 'S',
 	Opt_trace      = 'T',
@@ -108,9 +122,15 @@ enum
 	
 	Opt_last_byte = 255,
 	
+	Opt_blocks,
+	Opt_check_native_traps,
+	Opt_native_trap,
 	Opt_pid,
+	Opt_profile,
 	Opt_raster,
 	Opt_screen,
+	Opt_snapshot,
+	Opt_save_snapshot,
 	Opt_ignore_screen_locks,
 };
 
@@ -122,12 +142,19 @@ static command::option options[] =
 	{ "trace",      Opt_trace      },
 	{ "turbo",      Opt_turbo      },
 	{ "verbose",    Opt_verbose    },
+	{ "blocks",     Opt_blocks     },
+	{ "batch",      Opt_batch,  command::Param_optional },
 	{ "pid",        Opt_pid,    command::Param_optional },
+	{ "profile",    Opt_profile, command::Param_required },
+	{ "native-trap", Opt_native_trap, command::Param_required },
 	{ "raster",     Opt_raster, command::Param_required },
 	{ "screen",     Opt_screen, command::Param_required },
 	{ "module",     Opt_module, command::Param_required },
+	{ "snapshot",   Opt_snapshot, command::Param_required },
+	{ "save-snapshot", Opt_save_snapshot, command::Param_required },
 	
 	{ "ignore-screen-locks", Opt_ignore_screen_locks },
+	{ "check-native-traps",  Opt_check_native_traps  },
 	
 	{ NULL }
 };
@@ -146,6 +173,18 @@ void exit_with_message( const char* msg, unsigned len, int status )
 static
 void atexit_report()
 {
+	if ( profiling )
+	{
+		write_profile();
+	}
+	
+	if ( checking_native_traps )
+	{
+		report_native_trap_checks();
+	}
+	
+	report_batch_instruction_count( n_instructions );
+	
 	if ( verbose )
 	{
 		const char* count = gear::inscribe_unsigned_decimal( n_instructions );
@@ -153,6 +192,12 @@ void atexit_report()
 		write( STDERR_FILENO, STR_LEN( "### Instruction count: " ) );
 		write( STDERR_FILENO, count, strlen( count ) );
 		write( STDERR_FILENO, STR_LEN( "\n" ) );
+		
+		count = gear::inscribe_unsigned_wide_decimal( n_cycles );
+		
+		write( STDERR_FILENO, STR_LEN( "### Cycle count (approx. 68000): " ) );
+		write( STDERR_FILENO, count, strlen( count ) );
+		write( STDERR_FILENO, STR_LEN( "\n" ) );
 	}
 }
 
@@ -555,6 +600,56 @@ unsigned parse_instruction_limit( const char* var )
 	return gear::parse_unsigned_decimal( var );
 }
 
+static inline
+unsigned long block_budget( unsigned long n, unsigned max_steps )
+{
+	/*
+		Don't let a block run past the next polling/yield point (when the
+		low 16 bits of the count wrap) or the instruction limit, so that
+		both are still observed on exactly the same instruction as when
+		single-stepping.
+	*/
+	
+	unsigned long budget = 0x10000 - (n & 0xFFFF);
+	
+	if ( max_steps != 0  &&  n <= max_steps  &&  max_steps + 1 - n < budget )
+	{
+		budget = max_steps + 1 - n;
+	}
+	
+	return budget;
+}
+
+static inline
+bool step( v68k::emulator& emu, unsigned max_steps )
+{
+	if ( profiling )
+	{
+		profile_instruction( emu.pc(), emu.opcode );
+	}
+	
+	if ( checking_native_traps )
+	{
+		check_native_traps( emu );
+	}
+	
+	if ( turbo  &&  native_override( emu ) )
+	{
+		return true;
+	}
+	
+	// Profiling and checking observe every instruction, overriding --blocks.
+	
+	if ( blocks  &&  ! profiling  &&  ! checking_native_traps )
+	{
+		const unsigned long n = emu.instruction_count();
+		
+		return emu.run_block( block_budget( n, max_steps ) );
+	}
+	
+	return emu.step();
+}
+
 static
 void emulation_loop( v68k::emulator& emu )
 {
@@ -564,9 +659,10 @@ void emulation_loop( v68k::emulator& emu )
 	
 	const unsigned max_steps = parse_instruction_limit( instruction_limit_var );
 	
-	while ( (turbo  &&  native_override( emu ))  ||  emu.step() )
+	while ( step( emu, max_steps ) )
 	{
 		n_instructions = emu.instruction_count();
+		n_cycles       = emu.cycle_count();
 		
 		if ( max_steps != 0  &&  emu.instruction_count() > max_steps )
 		{
@@ -697,6 +793,59 @@ void load_file( uint8_t* mem, const char* path )
 	*p++ = iota::big_u16( 0x4E75 );  // Terminates function name lookup
 }
 
+static
+int run_program( v68k::emulator& emu, uint8_t* mem, int argc, char* const* argv )
+{
+	load_argv( mem, argc, argv );
+	
+	const char* path = argv[0];
+	
+	if ( tracing )
+	{
+		uint16_t* p = (uint16_t*) (mem + code_address);
+		
+		*p++ = v68k::big_word( 0x4EB8 );  // JSR
+		*p++ = v68k::big_word( 0xFFF4 );  //   trace_on
+		
+		mem += 4;
+	}
+	
+	load_code( mem, path );
+	
+	emu.reset();
+	
+	emulation_loop( emu );
+	
+	report_condition( emu );
+	
+	dump( emu );
+	
+	return 1;
+}
+
+struct batch_context
+{
+	v68k::emulator&  emu;
+	uint8_t*         mem;
+};
+
+static
+int run_batch_program( void* context, char* const* argv )
+{
+	batch_context& batch = *(batch_context*) context;
+	
+	/*
+		The parent reports its own profile and native trap checks.  The
+		child leaves those alone, and its 68K implementations, which
+		stayed installed for checking, now just run unchecked.
+	*/
+	
+	profiling             = false;
+	checking_native_traps = false;
+	
+	return run_program( batch.emu, batch.mem, 1, argv );
+}
+
 static
 int execute_68k( int argc, char* const* argv )
 {
@@ -721,6 +870,18 @@ int execute_68k( int argc, char* const* argv )
 	
 	load_Mac_traps( mem );
 	
+	if ( snapshot_path )
+	{
+		// Replaces the vectors and trap tables, as well as any modules
+		
+		if ( int err = load_snapshot( snapshot_path, emu, mem, mem_size ) )
+		{
+			more::perror( "xv68k", snapshot_path, err );
+			
+			exit( 1 );
+		}
+	}
+	
 	char* empty_module_argv[] = { NULL };
 	
 	for ( const module_spec* m = module_specs;  m->name != NULL;  ++m  )
@@ -751,31 +912,35 @@ int execute_68k( int argc, char* const* argv )
 		}
 	}
 	
-	load_argv( mem, argc, argv );
+	if ( save_snapshot_path )
+	{
+		if ( int err = save_snapshot( save_snapshot_path, emu, mem, mem_size ) )
+		{
+			more::perror( "xv68k", save_snapshot_path, err );
+			
+			exit( 1 );
+		}
+	}
 	
-	const char* path = argv[0];
+	install_native_traps( mem, checking_native_traps );
 	
-	if ( tracing )
+	if ( batch_jobs )
 	{
-		uint16_t* p = (uint16_t*) (mem + code_address);
+		batch_context context = { emu, mem };
 		
-		*p++ = v68k::big_word( 0x4EB8 );  // JSR
-		*p++ = v68k::big_word( 0xFFF4 );  //   trace_on
+		int n_failed = run_batch( batch_jobs, argv, &run_batch_program, &context );
 		
-		mem += 4;
+		if ( n_failed < 0 )
+		{
+			more::perror( "xv68k", "batch" );
+			
+			return 1;
+		}
+		
+		return n_failed != 0;
 	}
 	
-	load_code( mem, path );
-	
-	emu.reset();
-	
-	emulation_loop( emu );
-	
-	report_condition( emu );
-	
-	dump( emu );
-	
-	return 1;
+	return run_program( emu, mem, argc, argv );
 }
 
 static inline
@@ -839,6 +1004,27 @@ char* const* get_options( char** argv )
 				verbose = true;
 				break;
 			
+			case Opt_blocks:
+				blocks = true;
+				break;
+			
+			case Opt_batch:
+				batch_jobs = sysconf( _SC_NPROCESSORS_ONLN );
+				
+				if ( global_result.param )
+				{
+					using gear::parse_unsigned_decimal;
+					
+					batch_jobs = parse_unsigned_decimal( &global_result.param );
+				}
+				
+				if ( (int) batch_jobs <= 0 )
+				{
+					batch_jobs = 1;
+				}
+				
+				break;
+			
 			case Opt_pid:
 				if ( global_result.param )
 				{
@@ -853,6 +1039,42 @@ char* const* get_options( char** argv )
 				
 				break;
 			
+			case Opt_check_native_traps:
+				checking_native_traps = true;
+				break;
+			
+			case Opt_native_trap:
+				if ( ! enable_native_trap( global_result.param ) )
+				{
+					const char* name = global_result.param;
+					
+					write( STDERR_FILENO, STR_LEN( "xv68k: no native trap: " ) );
+					write( STDERR_FILENO, name, strlen( name ) );
+					write( STDERR_FILENO, STR_LEN( "\n" ) );
+					
+					exit( 2 );
+				}
+				
+				break;
+			
+			case Opt_profile:
+				if ( int err = open_profile( global_result.param ) )
+				{
+					const char* path  = global_result.param;
+					const char* error = strerror( err );
+					
+					write( STDERR_FILENO, path, strlen( path ) );
+					write( STDERR_FILENO, STR_LEN( ": " ) );
+					write( STDERR_FILENO, error, strlen( error ) );
+					write( STDERR_FILENO, STR_LEN( "\n" ) );
+					
+					exit( 1 );
+				}
+				
+				profiling = true;
+				
+				break;
+			
 			case Opt_raster:
 			case Opt_screen:
 				if ( has_screen )
@@ -885,6 +1107,14 @@ char* const* get_options( char** argv )
 				
 				break;
 			
+			case Opt_snapshot:
+				snapshot_path = global_result.param;
+				break;
+			
+			case Opt_save_snapshot:
+				save_snapshot_path = global_result.param;
+				break;
+			
 			case Opt_module:
 				module->name = global_result.param;
 				
@@ -236,5 +236,69 @@ uint8_t* translate( addr_t addr, uint32_t length, fc_t fc, mem_t access )
 	return (uint8_t*) page_alloc + offset;
 }
 
+uint32_t next_block( uint32_t addr, uint32_t* n_pages, void** alloc )
+{
+	if ( addr < start )
+	{
+		addr = start;
+	}
+	
+	for ( uint32_t i = (addr - start) / page_size;  i < n_alloc_pages;  ++i )
+	{
+		void* page_alloc = alloc_pages[ i ];
+		
+		if ( page_alloc == NULL  ||  page_alloc == (void*) -1L )
+		{
+			continue;
+		}
+		
+		uint32_t n = 1;
+		
+		while ( alloc_pages[ i + n ] == (char*) page_alloc + n * page_size )
+		{
+			++n;
+		}
+		
+		*n_pages = n;
+		*alloc   = page_alloc;
+		
+		return start + i * page_size;
+	}
+	
+	return 0;
+}
+
+bool restore_block( uint32_t addr, uint32_t n_pages, void* alloc )
+{
+	if ( addr < start  ||  addr >= limit  ||  (addr - start) % page_size )
+	{
+		return false;
+	}
+	
+	const unsigned first = (addr - start) / page_size;
+	
+	if ( n_pages > n_alloc_pages - first )
+	{
+		return false;
+	}
+	
+	for ( unsigned i = first;  i < first + n_pages;  ++i )
+	{
+		if ( alloc_pages[ i ] != NULL )
+		{
+			return false;
+		}
+	}
+	
+	for ( unsigned i = first;  i < first + n_pages;  ++i )
+	{
+		alloc_pages[ i ] = alloc;
+		
+		alloc = (char*) alloc + page_size;
+	}
+	
+	return true;
+}
+
 }  // namespace alloc
 }  // namespace v68k
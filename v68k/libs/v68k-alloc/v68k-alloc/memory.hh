@@ -56,6 +56,17 @@ void deallocate( uint32_t addr );
 
 uint8_t* translate( addr_t addr, uint32_t length, fc_t fc, mem_t access );
 
+/*
+	Snapshot support:  A block is a run of pages backed by contiguous host
+	memory.  next_block() finds the first block at or after addr, returning
+	its address (or 0 if there are no more).  restore_block() maps a block
+	at the address it was found at.
+*/
+
+uint32_t next_block( uint32_t addr, uint32_t* n_pages, void** alloc );
+
+bool restore_block( uint32_t addr, uint32_t n_pages, void* alloc );
+
 }  // namespace alloc
 }  // namespace v68k
 
@@ -31,6 +31,9 @@
 // v68k-auth
 #include "auth/auth.hh"
 
+// v68k-callouts
+#include "callout/native_traps.hh"
+
 // v68k-screen
 #include "screen/lock.hh"
 #include "screen/surface.hh"
@@ -398,6 +401,8 @@ int32_t dealloc_callout( v68k::processor_state& s )
 	
 	v68k::alloc::deallocate( addr );
 	
+	s.mem.flush_cached_pages();  // the pages may have been cached as flat
+	
 	s.d(0) = noErr;
 	
 	return rts;
@@ -599,6 +604,17 @@ int32_t Gestalt_callout( v68k::processor_state& s )
 	return rts;
 }
 
+#define DEFINE_NATIVE_TRAP_CALLOUT( name, trap_word, params, result_size )  \
+	static                                                                \
+	int32_t name##_callout( v68k::processor_state& s )                    \
+	{                                                                     \
+		return call_native_trap( s, the_native_traps[ name##_native ] );  \
+	}
+
+FOR_EACH_NATIVE_TRAP( DEFINE_NATIVE_TRAP_CALLOUT )
+
+#undef DEFINE_NATIVE_TRAP_CALLOUT
+
 
 static
 int32_t bus_error_callout( v68k::processor_state& s )
@@ -767,10 +783,43 @@ static const function_type the_callouts[] =
 	&unimplemented_trap_callout,
 	&BlockMove_callout,
 	&Gestalt_callout,
+	
+#define NATIVE_TRAP_CALLOUT( name, trap_word, params, result_size )  &name##_callout,
+	
+	FOR_EACH_NATIVE_TRAP( NATIVE_TRAP_CALLOUT )
+	
+#undef NATIVE_TRAP_CALLOUT
+	
 	&unimplemented_callout
 };
 
 
+uint32_t callout_fingerprint()
+{
+	/*
+		Hash each callout's offset from bridge(), which is the same in
+		every run of one binary (even if it's loaded at a different base
+		address) but not across builds that change the callouts.
+	*/
+	
+	const size_t n_callouts = sizeof the_callouts / sizeof the_callouts[0];
+	
+	const uintptr_t base = (uintptr_t) &bridge;
+	
+	uint32_t hash = n_callouts;
+	
+	for ( size_t i = 0;  i < n_callouts;  ++i )
+	{
+		const function_type f = the_callouts[ i ];
+		
+		const uint32_t offset = f ? (uintptr_t) f - base : 0;
+		
+		hash = (hash ^ offset) * 0x01000193;  // FNV-1a prime
+	}
+	
+	return hash;
+}
+
 int32_t bridge( v68k::processor_state& s )
 {
 	const int32_t pc = s.pc();
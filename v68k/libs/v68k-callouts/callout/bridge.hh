@@ -9,6 +9,9 @@
 // v68k
 #include "v68k/state.hh"
 
+// v68k-callouts
+#include "callout/native_trap_list.hh"
+
 
 namespace v68k    {
 namespace callout {
@@ -66,6 +69,13 @@ enum
 	unimplemented_trap,
 	BlockMove_trap,
 	Gestalt_trap,
+	
+#define NATIVE_TRAP_CALLOUT( name, trap_word, params, result_size )  name##_trap,
+	
+	FOR_EACH_NATIVE_TRAP( NATIVE_TRAP_CALLOUT )
+	
+#undef NATIVE_TRAP_CALLOUT
+	
 	unimplemented,
 	n
 };
@@ -78,6 +88,8 @@ uint32_t callout_address( int index )
 
 int32_t bridge( v68k::processor_state& emu );
 
+uint32_t callout_fingerprint();
+
 }  // namespace callout
 }  // namespace v68k
 
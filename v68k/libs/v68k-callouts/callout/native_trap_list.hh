@@ -0,0 +1,24 @@
+/*
+	native_trap_list.hh
+	-------------------
+*/
+
+#ifndef CALLOUT_NATIVETRAPLIST_HH
+#define CALLOUT_NATIVETRAPLIST_HH
+
+/*
+	The one list of native traps, from which the callout numbers, the
+	callout functions, and the_native_traps[] are all generated, in order.
+	
+	X( name, trap word, param sizes, result size )
+*/
+
+#define FOR_EACH_NATIVE_TRAP( X )     \
+	X( FixDiv,   0xA84D, "LL", 4 )    \
+	X( FixMul,   0xA868, "LL", 4 )    \
+	X( FixRatio, 0xA869, "WW", 4 )    \
+	X( HiWord,   0xA86A, "L",  2 )    \
+	X( LoWord,   0xA86B, "L",  2 )    \
+	X( FixRound, 0xA86C, "L",  2 )
+
+#endif
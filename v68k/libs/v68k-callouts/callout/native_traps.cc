@@ -0,0 +1,173 @@
+/*
+	native_traps.cc
+	---------------
+*/
+
+#include "callout/native_traps.hh"
+
+// Standard C
+#include <string.h>
+
+// quickdraw
+#include "qd/fixed.hh"
+
+// v68k-callouts
+#include "callout/bridge.hh"
+
+
+#pragma exceptions off
+
+
+namespace v68k    {
+namespace callout {
+
+enum
+{
+	rts = 0x4E75,
+};
+
+static
+uint32_t FixMul( const uint32_t* params )
+{
+	return quickdraw::fix_mul( int32_t( params[ 0 ] ), int32_t( params[ 1 ] ) );
+}
+
+static
+uint32_t FixRatio( const uint32_t* params )
+{
+	return quickdraw::fix_ratio( params[ 0 ], params[ 1 ] );
+}
+
+static
+uint32_t FixDiv( const uint32_t* params )
+{
+	return quickdraw::fix_div( int32_t( params[ 0 ] ), int32_t( params[ 1 ] ) );
+}
+
+static
+uint32_t FixRound( const uint32_t* params )
+{
+	return uint16_t( quickdraw::fix_round( int32_t( params[ 0 ] ) ) );
+}
+
+static
+uint32_t HiWord( const uint32_t* params )
+{
+	return params[ 0 ] >> 16;
+}
+
+static
+uint32_t LoWord( const uint32_t* params )
+{
+	return params[ 0 ] & 0xFFFF;
+}
+
+const native_trap the_native_traps[] =
+{
+#define NATIVE_TRAP_ENTRY( name, trap_word, params, result_size )  \
+	{ #name, trap_word, name##_trap, params, result_size, &name },
+	
+	FOR_EACH_NATIVE_TRAP( NATIVE_TRAP_ENTRY )
+	
+#undef NATIVE_TRAP_ENTRY
+	
+	{ NULL }
+};
+
+const native_trap* find_native_trap( const char* name )
+{
+	for ( const native_trap* it = the_native_traps;  it->name;  ++it )
+	{
+		if ( strcmp( it->name, name ) == 0 )
+		{
+			return it;
+		}
+	}
+	
+	return NULL;
+}
+
+unsigned params_size( const native_trap& trap )
+{
+	unsigned size = 0;
+	
+	for ( const char* p = trap.param_sizes;  *p != '\0';  ++p )
+	{
+		size += *p == 'L' ? 4 : 2;
+	}
+	
+	return size;
+}
+
+bool get_params( const v68k::processor_state&  s,
+                 const native_trap&            trap,
+                 uint32_t                      sp,
+                 uint32_t*                     params )
+{
+	// The last parameter is nearest the return address at the top of stack.
+	
+	uint32_t addr = sp + 4 + params_size( trap );
+	
+	for ( const char* p = trap.param_sizes;  *p != '\0';  ++p )
+	{
+		bool ok;
+		
+		if ( *p == 'L' )
+		{
+			addr -= 4;
+			
+			ok = s.mem.get_long( addr, *params++, s.data_space() );
+		}
+		else
+		{
+			uint16_t word;
+			
+			addr -= 2;
+			
+			ok = s.mem.get_word( addr, word, s.data_space() );
+			
+			*params++ = word;
+		}
+		
+		if ( ! ok )
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int32_t call_native_trap( v68k::processor_state& s, const native_trap& trap )
+{
+	uint32_t& sp = s.a(7);
+	
+	uint32_t params[ 4 ];
+	uint32_t return_address;
+	
+	if ( ! s.mem.get_long( sp, return_address, s.data_space() )  ||
+	     ! get_params( s, trap, sp, params ) )
+	{
+		return v68k::Bus_error;
+	}
+	
+	const uint32_t result = trap.compute( params );
+	
+	// Pop the parameters, leaving the return address above the result.
+	
+	sp += params_size( trap );
+	
+	const bool ok = trap.result_size == 4
+	              ? s.mem.put_long( sp + 4, result, s.data_space() )
+	              : s.mem.put_word( sp + 4, result, s.data_space() );
+	
+	if ( ! ok  ||  ! s.mem.put_long( sp, return_address, s.data_space() ) )
+	{
+		return v68k::Bus_error;
+	}
+	
+	return rts;
+}
+
+}  // namespace callout
+}  // namespace v68k
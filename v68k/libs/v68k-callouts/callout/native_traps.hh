@@ -0,0 +1,74 @@
+/*
+	native_traps.hh
+	---------------
+*/
+
+#ifndef CALLOUT_NATIVETRAPS_HH
+#define CALLOUT_NATIVETRAPS_HH
+
+// v68k
+#include "v68k/state.hh"
+
+// v68k-callouts
+#include "callout/native_trap_list.hh"
+
+
+namespace v68k    {
+namespace callout {
+
+/*
+	Host implementations of pure-computation Toolbox functions, which can
+	stand in for the 68K implementations installed by the AMS modules.
+	
+	Each is a Pascal-convention function:  The caller reserves space for
+	the result, pushes the parameters in declared order, and calls the trap.
+	The callee pops the parameters and leaves the result on the stack.
+	
+	Only functions of their parameters are covered.  Region operations
+	like SectRgn(), UnionRgn(), and OffsetRgn() are procedures that modify
+	a region through a handle, and the first two must resize it with the
+	68K Memory Manager, which a callout can't call; nor could the checker
+	compare their results, since it only compares returned values.
+*/
+
+enum native_trap_index
+{
+#define NATIVE_TRAP_INDEX( name, trap_word, params, result_size )  name##_native,
+	
+	FOR_EACH_NATIVE_TRAP( NATIVE_TRAP_INDEX )
+	
+#undef NATIVE_TRAP_INDEX
+	
+	n_native_traps
+};
+
+typedef uint32_t (*pascal_function)( const uint32_t* params );
+
+struct native_trap
+{
+	const char*      name;
+	uint16_t         trap_word;
+	uint16_t         callout;      // index into the callout table
+	const char*      param_sizes;  // 'W' or 'L' for each param, in order
+	uint8_t          result_size;  // 2 or 4
+	pascal_function  compute;
+};
+
+extern const native_trap the_native_traps[];
+
+const native_trap* find_native_trap( const char* name );
+
+unsigned params_size( const native_trap& trap );
+
+bool get_params( const v68k::processor_state&  s,
+                 const native_trap&            trap,
+                 uint32_t                      sp,
+                 uint32_t*                     params );
+
+int32_t call_native_trap( v68k::processor_state& s, const native_trap& trap );
+
+}  // namespace callout
+}  // namespace v68k
+
+
+#endif
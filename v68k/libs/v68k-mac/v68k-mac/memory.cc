@@ -380,6 +380,13 @@ static uint8_t* update_globals( const global* g, uint32_t addr, uint32_t size )
 	return buffer;
 }
 
+uint8_t* globals_storage( uint32_t* size )
+{
+	*size = sizeof words;
+	
+	return (uint8_t*) words;
+}
+
 uint8_t* translate( addr_t addr, uint32_t length, fc_t fc, mem_t access )
 {
 	if ( access == mem_exec )
@@ -17,6 +17,9 @@ extern bool ticking;
 
 uint8_t* translate( addr_t addr, uint32_t length, fc_t fc, mem_t access );
 
+// Host storage for the emulated low memory globals, for snapshots
+uint8_t* globals_storage( uint32_t* size );
+
 }  // namespace mac
 }  // namespace v68k
 
@@ -0,0 +1,61 @@
+/*
+	decode_cache.cc
+	---------------
+*/
+
+#include "v68k/decode_cache.hh"
+
+// v68k
+#include "v68k/decode.hh"
+
+
+#pragma exceptions off
+
+
+namespace v68k
+{
+	
+	static op_size_t resolved_size( uint16_t opcode, op_size_t size )
+	{
+		if ( size > max_actual_size )
+		{
+			const uint16_t size_mask = size;
+			
+			const int bit_offset = size & op_size_shift_mask;
+			
+			// 1 if 0 means byte-sized, 2 if 0 means word-sized
+			const uint32_t index_of_zero = 1 + (size & 1);
+			
+			size = op_size_t( ((opcode & size_mask) >> bit_offset) + index_of_zero );
+		}
+		
+		return size;
+	}
+	
+	void decode_cache::fill( decoded_instruction& entry, uint16_t opcode )
+	{
+		instruction storage = { 0 };
+		
+		if ( const instruction* decoded = decode( opcode, storage ) )
+		{
+			entry.insn = *decoded;
+			entry.size = resolved_size( opcode, decoded->size );
+			
+			entry.timing = timing_of( opcode, entry.size );
+		}
+		else
+		{
+			const instruction undefined = { 0 };
+			
+			entry.insn = undefined;
+			entry.size = unsized;
+			
+			const instruction_timing untimed = { 0 };
+			
+			entry.timing = untimed;
+		}
+		
+		entry.key = opcode | key_valid;
+	}
+	
+}
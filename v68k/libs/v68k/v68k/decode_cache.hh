@@ -0,0 +1,81 @@
+/*
+	decode_cache.hh
+	---------------
+*/
+
+#ifndef V68K_DECODECACHE_HH
+#define V68K_DECODECACHE_HH
+
+// C99
+#include <stdint.h>
+
+// v68k
+#include "v68k/instruction.hh"
+#include "v68k/op_params.hh"
+#include "v68k/timing.hh"
+
+
+namespace v68k
+{
+	
+	/*
+		decode() is a pure function of the opcode -- it doesn't look at the
+		PC, the memory, or the processor state.  So rather than key decoded
+		instructions by address (and have to notice when code is overwritten),
+		we key them by opcode, which never needs invalidation.
+		
+		An entry whose instruction has a NULL microcode is an opcode that
+		doesn't decode (e.g. an A-trap).
+	*/
+	
+	struct decoded_instruction
+	{
+		instruction  insn;
+		op_size_t    size;  // operand size, already resolved from the opcode
+		
+		instruction_timing  timing;
+		
+		uint32_t     key;   // opcode | key_valid, or 0 if empty
+	};
+	
+	class decode_cache
+	{
+		private:
+			enum
+			{
+				key_valid = 0x10000,
+				n_entries = 4096
+			};
+			
+			decoded_instruction its_entries[ n_entries ];
+			
+			static unsigned index_of( uint16_t opcode )
+			{
+				// Fold the line (top nibble) into the register field.
+				
+				return (opcode ^ opcode >> 12) & (n_entries - 1);
+			}
+			
+			static void fill( decoded_instruction& entry, uint16_t opcode );
+		
+		public:
+			decode_cache() : its_entries()
+			{
+			}
+			
+			const decoded_instruction& lookup( uint16_t opcode )
+			{
+				decoded_instruction& entry = its_entries[ index_of( opcode ) ];
+				
+				if ( entry.key != (opcode | key_valid) )
+				{
+					fill( entry, opcode );
+				}
+				
+				return entry;
+			}
+	};
+	
+}
+
+#endif
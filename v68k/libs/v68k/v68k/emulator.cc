@@ -6,7 +6,6 @@
 #include "v68k/emulator.hh"
 
 // v68k
-#include "v68k/decode.hh"
 #include "v68k/instruction.hh"
 #include "v68k/load_store.hh"
 #include "v68k/update_CCR.hh"
@@ -21,14 +20,56 @@ namespace v68k
 	emulator::emulator( processor_model model, const memory& mem, bkpt_handler bkpt )
 	:
 		processor_state( model, mem, bkpt ),
-		its_instruction_counter()
+		its_instruction_counter(),
+		its_cycle_counter(),
+		its_sequential_pc(),
+		its_deferred_CCR_update(),
+		its_deferred_X_update()
 	{
 	}
 	
+	static inline bool defers_CCR_update( instruction_flags_t flags )
+	{
+		/*
+			The ADD, SUB/CMP, basic (N and Z from the result), and DIV updates
+			overwrite NZVC without looking at it, so they can be put off until
+			something actually reads the CCR -- by which time another such
+			update has usually replaced them.  The ADDX/SUBX (Z &= ...) and
+			BTST (Z only) updates depend on the existing flags.
+		*/
+		
+		const int ccr_flags = flags & CCR_update_mask;
+		
+		const int index = ccr_flags >> CCR_update_shift;
+		
+		const int deferrable = 1 << 0 | 1 << 1 | 1 << 4 | 1 << 6;
+		
+		return ccr_flags != 0  &&  deferrable >> index & 1;
+	}
+	
+	void emulator::flush_CCR()
+	{
+		if ( its_deferred_CCR_update )
+		{
+			const int index = its_deferred_CCR_update - 1;
+			
+			the_CCR_updaters[ index ]( *this, its_deferred_CCR_params );
+			
+			if ( its_deferred_X_update )
+			{
+				sr.x = sr.nzvc & 0x1;
+			}
+			
+			its_deferred_CCR_update = 0;
+		}
+	}
+	
 	void emulator::reset()
 	{
 		condition = normal;
 		
+		its_deferred_CCR_update = 0;
+		
 		regs[ VBR ] = 0;
 		
 		/*
@@ -61,6 +102,23 @@ namespace v68k
 	
 	bool emulator::step()
 	{
+		const bool ok = step_deferring_CCR();
+		
+		flush_CCR();
+		
+		return ok;
+	}
+	
+	bool emulator::step_deferring_CCR()
+	{
+		/*
+			Like step(), except that a deferrable CCR update may be left
+			pending.  Anything that might read the CCR -- an instruction
+			that doesn't itself overwrite it, or an exception -- flushes it
+			first, and the public entry points flush before returning, so
+			the deferral is never visible outside the emulator.
+		*/
+		
 	bkpt_acknowledge:
 		
 		if ( condition != normal )
@@ -69,9 +127,9 @@ namespace v68k
 		}
 		
 		// decode (prefetched)
-		instruction storage = { 0 };
+		const decoded_instruction& cached = its_decode_cache.lookup( opcode );
 		
-		const instruction* decoded = decode( opcode, storage );
+		const instruction* decoded = cached.insn.code ? &cached.insn : 0;  // NULL
 		
 		if ( !decoded )
 		{
@@ -88,6 +146,11 @@ namespace v68k
 			}
 		}
 		
+		if ( its_deferred_CCR_update  &&  !defers_CCR_update( decoded->flags ) )
+		{
+			flush_CCR();
+		}
+		
 		if ( (decoded->flags & not_before_mask) > model )
 		{
 			return illegal_instruction();
@@ -108,19 +171,7 @@ namespace v68k
 		
 		op_params pb;
 		
-		pb.size = decoded->size;
-		
-		if ( pb.size > max_actual_size )
-		{
-			const uint16_t size_mask = pb.size;
-			
-			const int bit_offset = pb.size & op_size_shift_mask;
-			
-			// 1 if 0 means byte-sized, 2 if 0 means word-sized
-			const uint32_t index_of_zero = 1 + (pb.size & 1);
-			
-			pb.size = op_size_t( ((opcode & size_mask) >> bit_offset) + index_of_zero );
-		}
+		pb.size = cached.size;
 		
 		pb.target  = uint32_t( -1 );
 		pb.address = pc();
@@ -140,6 +191,8 @@ namespace v68k
 			}
 		}
 		
+		its_sequential_pc = pc();
+		
 		// load/store prep
 		
 		if (
@@ -225,11 +278,27 @@ namespace v68k
 				
 				const int index = ccr_flags >> CCR_update_shift;
 				
-				the_CCR_updaters[ index ]( *this, pb );
+				const bool sets_X = decoded->flags & CCR_update_set_X;
 				
-				if ( decoded->flags & CCR_update_set_X )
+				if ( defers_CCR_update( decoded->flags ) )
 				{
-					sr.x = sr.nzvc & 0x1;
+					if ( its_deferred_X_update  &&  !sets_X )
+					{
+						flush_CCR();  // X still comes from the pending update
+					}
+					
+					its_deferred_CCR_update = index + 1;
+					its_deferred_X_update   = sets_X;
+					its_deferred_CCR_params = pb;
+				}
+				else
+				{
+					the_CCR_updaters[ index ]( *this, pb );
+					
+					if ( sets_X )
+					{
+						sr.x = sr.nzvc & 0x1;
+					}
 				}
 			}
 		}
@@ -243,6 +312,9 @@ namespace v68k
 		
 		++its_instruction_counter;
 		
+		its_cycle_counter += pc() == its_sequential_pc ? cached.timing.cycles
+		                                               : cached.timing.taken_cycles;
+		
 		if ( (saved_ttsm >> 2) - 1 > 0  &&  condition >= normal )
 		{
 			if ( condition == stopped )
@@ -259,6 +331,53 @@ namespace v68k
 		return condition == normal;
 	}
 	
+	bool emulator::continues_block( uint16_t next_opcode )
+	{
+		/*
+			Stop short of anything the host might want to intercept between
+			steps:  A-line traps and other undecoded opcodes (which will
+			raise an exception anyway), and BKPT.
+		*/
+		
+		if ( (next_opcode & 0xFFF8) == 0x4848 )
+		{
+			return false;  // BKPT
+		}
+		
+		return its_decode_cache.lookup( next_opcode ).insn.code != 0;  // NULL
+	}
+	
+	bool emulator::run_block( unsigned long n_max )
+	{
+		/*
+			Run straight-line code, dispatching directly on the cached decoded
+			instructions, until control flow goes anywhere other than the next
+			instruction (a taken branch, jump, trap, or exception), or until
+			n_max instructions have executed.  The instruction count stays
+			exact, so callers can budget blocks to land on their own polling
+			boundaries.
+		*/
+		
+		const unsigned long limit = its_instruction_counter + n_max;
+		
+		bool ok;
+		
+		do
+		{
+			its_sequential_pc = uint32_t( -1 );  // odd, so never a valid PC
+			
+			ok = step_deferring_CCR();
+		}
+		while ( ok                               &&
+		        pc() == its_sequential_pc        &&
+		        its_instruction_counter < limit  &&
+		        continues_block( opcode ) );
+		
+		flush_CCR();
+		
+		return ok;
+	}
+	
 	void emulator::prefetch_instruction_word()
 	{
 		if ( pc() & 1 )
@@ -275,6 +394,10 @@ namespace v68k
 	                               uint16_t  vector_offset,
 	                               uint32_t  instruction_address )
 	{
+		flush_CCR();
+		
+		its_cycle_counter += exception_processing_cycles;
+		
 		const uint16_t saved_sr = get_SR();
 		
 		set_SR( (saved_sr & 0x3FFF) | 0x2000 );  // Clear T1/T0, set S
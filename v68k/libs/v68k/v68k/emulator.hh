@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 // v68k
+#include "v68k/decode_cache.hh"
 #include "v68k/state.hh"
 
 
@@ -21,6 +22,22 @@ namespace v68k
 		private:
 			unsigned long its_instruction_counter;
 			
+			uint64_t its_cycle_counter;  // approximate, see timing.hh
+			
+			decode_cache its_decode_cache;
+			
+			uint32_t its_sequential_pc;  // where the current instruction falls through
+			
+			int        its_deferred_CCR_update;  // updater index + 1, or 0
+			bool       its_deferred_X_update;
+			op_params  its_deferred_CCR_params;
+			
+			void flush_CCR();
+			
+			bool step_deferring_CCR();
+			
+			bool continues_block( uint16_t next_opcode );
+			
 			void double_bus_fault()  { condition = halted; }
 			
 			uint32_t bus_error    ()  { condition = halted;  return 0; }
@@ -31,10 +48,14 @@ namespace v68k
 			
 			unsigned long instruction_count() const  { return its_instruction_counter; }
 			
+			uint64_t cycle_count() const  { return its_cycle_counter; }
+			
 			void reset();
 			
 			bool step();
 			
+			bool run_block( unsigned long n_max );
+			
 			void prefetch_instruction_word();
 			
 			bool take_exception( uint16_t  format,
@@ -98,9 +98,45 @@ namespace v68k
 	}
 	
 	
+	uint8_t* memory::translate_uncached( addr_t a, uint32_t n, fc_t fc, mem_t mem ) const
+	{
+		const uint32_t offset = a & (page_size - 1);
+		
+		if ( its_flat_page  &&  offset + n <= page_size )
+		{
+			const addr_t page_addr = a - offset;
+			
+			if ( uint8_t* base = its_flat_page( page_addr, fc, mem ) )
+			{
+				const addr_t page = a >> page_size_bits;
+				
+				cached_page& cached = its_cached_pages[ mem ][ page & (n_cached_pages - 1) ];
+				
+				cached.tag  = page | fc << 20 | 1 << 23;
+				cached.base = base;
+				
+				return base + offset;
+			}
+		}
+		
+		return translate( a, n, fc, mem );
+	}
+	
+	void memory::flush_cached_pages() const
+	{
+		for ( int i = 0;  i < 3;  ++i )
+		{
+			for ( int j = 0;  j < n_cached_pages;  ++j )
+			{
+				its_cached_pages[ i ][ j ].tag = 0;
+			}
+		}
+	}
+	
+	
 	bool memory::get_byte( uint32_t addr, uint8_t& x, function_code_t fc ) const
 	{
-		if ( const uint8_t* p = translate( addr, sizeof (uint8_t), fc, mem_read ) )
+		if ( const uint8_t* p = translate_fast( addr, sizeof (uint8_t), fc, mem_read ) )
 		{
 			x = read_byte( p );
 			
@@ -112,7 +148,7 @@ namespace v68k
 	
 	bool memory::get_word( uint32_t addr, uint16_t& x, function_code_t fc ) const
 	{
-		if ( const uint8_t* p = translate( addr, sizeof (uint16_t), fc, mem_read ) )
+		if ( const uint8_t* p = translate_fast( addr, sizeof (uint16_t), fc, mem_read ) )
 		{
 			x = read_big_word_unaligned( p );
 			
@@ -124,7 +160,7 @@ namespace v68k
 	
 	bool memory::get_long( uint32_t addr, uint32_t& x, function_code_t fc ) const
 	{
-		if ( const uint8_t* p = translate( addr, sizeof (uint32_t), fc, mem_read ) )
+		if ( const uint8_t* p = translate_fast( addr, sizeof (uint32_t), fc, mem_read ) )
 		{
 			x = read_big_long_unaligned( p );
 			
@@ -137,7 +173,14 @@ namespace v68k
 	
 	bool memory::put_byte( uint32_t addr, uint8_t x, function_code_t fc ) const
 	{
-		if ( uint8_t* p = translate( addr, sizeof (uint8_t), fc, mem_write ) )
+		if ( uint8_t* p = cached_translation( addr, sizeof (uint8_t), fc, mem_write ) )
+		{
+			write_byte( p, x );
+			
+			return true;  // flat pages don't need mem_update
+		}
+		
+		if ( uint8_t* p = translate_uncached( addr, sizeof (uint8_t), fc, mem_write ) )
 		{
 			write_byte( p, x );
 			
@@ -151,7 +194,14 @@ namespace v68k
 	
 	bool memory::put_word( uint32_t addr, uint16_t x, function_code_t fc ) const
 	{
-		if ( uint8_t* p = translate( addr, sizeof (uint16_t), fc, mem_write ) )
+		if ( uint8_t* p = cached_translation( addr, sizeof (uint16_t), fc, mem_write ) )
+		{
+			write_big_word_unaligned( p, x );
+			
+			return true;  // flat pages don't need mem_update
+		}
+		
+		if ( uint8_t* p = translate_uncached( addr, sizeof (uint16_t), fc, mem_write ) )
 		{
 			write_big_word_unaligned( p, x );
 			
@@ -165,7 +215,14 @@ namespace v68k
 	
 	bool memory::put_long( uint32_t addr, uint32_t x, function_code_t fc ) const
 	{
-		if ( uint8_t* p = translate( addr, sizeof (uint32_t), fc, mem_write ) )
+		if ( uint8_t* p = cached_translation( addr, sizeof (uint32_t), fc, mem_write ) )
+		{
+			write_big_long_unaligned( p, x );
+			
+			return true;  // flat pages don't need mem_update
+		}
+		
+		if ( uint8_t* p = translate_uncached( addr, sizeof (uint32_t), fc, mem_write ) )
 		{
 			write_big_long_unaligned( p, x );
 			
@@ -180,7 +237,7 @@ namespace v68k
 	
 	bool memory::get_instruction_word( uint32_t addr, uint16_t& x, function_code_t fc ) const
 	{
-		if ( const uint8_t* p = translate( addr, sizeof (uint16_t), fc, mem_exec ) )
+		if ( const uint8_t* p = translate_fast( addr, sizeof (uint16_t), fc, mem_exec ) )
 		{
 			x = read_big_word_aligned( p );
 			
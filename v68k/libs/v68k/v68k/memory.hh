@@ -39,13 +39,74 @@ namespace v68k
 	
 	typedef uint8_t* (*translate_f)( addr_t a, uint32_t n, fc_t fc, mem_t mem );
 	
+	/*
+		A flat_page_f returns the host address of the page at the given
+		(page-aligned) address, if the whole page is plain host memory that
+		may be accessed by that function code in that way -- in particular,
+		writes to it must not require a mem_update notification.  Otherwise
+		it returns NULL, and accesses to the page go through translate_f.
+	*/
+	
+	typedef uint8_t* (*flat_page_f)( addr_t page, fc_t fc, mem_t mem );
+	
 	class memory
 	{
+		public:
+			enum
+			{
+				page_size_bits = 12,
+				page_size      = 1 << page_size_bits,  // 4K
+				
+				n_cached_pages = 256
+			};
+		
 		private:
-			translate_f its_translate;
+			struct cached_page
+			{
+				uint32_t  tag;   // page number | fc << 20 | 1 << 23, or 0
+				uint8_t*  base;
+			};
+			
+			translate_f  its_translate;
+			flat_page_f  its_flat_page;
+			
+			// one software TLB each for exec, read, and write access
+			mutable cached_page its_cached_pages[ 3 ][ n_cached_pages ];
+			
+			uint8_t* translate_uncached( addr_t a, uint32_t n, fc_t fc, mem_t mem ) const;
+			
+			uint8_t* cached_translation( addr_t a, uint32_t n, fc_t fc, mem_t mem ) const
+			{
+				const addr_t page = a >> page_size_bits;
+				
+				const cached_page& cached = its_cached_pages[ mem ][ page & (n_cached_pages - 1) ];
+				
+				const uint32_t offset = a & (page_size - 1);
+				
+				if ( cached.tag == (page | fc << 20 | 1 << 23)  &&  offset + n <= page_size )
+				{
+					return cached.base + offset;
+				}
+				
+				return 0;  // NULL
+			}
+			
+			uint8_t* translate_fast( addr_t a, uint32_t n, fc_t fc, mem_t mem ) const
+			{
+				if ( uint8_t* p = cached_translation( a, n, fc, mem ) )
+				{
+					return p;
+				}
+				
+				return translate_uncached( a, n, fc, mem );
+			}
 		
 		public:
-			memory( translate_f f ) : its_translate( f )
+			memory( translate_f f, flat_page_f flat = 0 )  // NULL
+			:
+				its_translate( f ),
+				its_flat_page( flat ),
+				its_cached_pages()
 			{
 			}
 			
@@ -54,6 +115,8 @@ namespace v68k
 				return its_translate( a, n, fc, mem );
 			}
 			
+			void flush_cached_pages() const;
+			
 			bool get_byte( addr_t addr, uint8_t & x, fc_t fc ) const;
 			bool get_word( addr_t addr, uint16_t& x, fc_t fc ) const;
 			bool get_long( addr_t addr, uint32_t& x, fc_t fc ) const;
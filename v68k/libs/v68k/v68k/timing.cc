@@ -0,0 +1,381 @@
+/*
+	timing.cc
+	---------
+*/
+
+#include "v68k/timing.hh"
+
+
+#pragma exceptions off
+
+
+namespace v68k
+{
+	
+	/*
+		Effective address calculation times (MC68000 User's Manual, table
+		8-1), indexed by mode 0-6, then by mode 7 register 0-4.
+	*/
+	
+	static const uint8_t ea_word_cycles[] =
+	{
+		0, 0, 4, 4, 6, 8, 10,  // Dn, An, (An), (An)+, -(An), d(An), d(An,Xi)
+		8, 12, 8, 10, 4        // abs.W, abs.L, d(PC), d(PC,Xi), #imm
+	};
+	
+	static const uint8_t ea_long_cycles[] =
+	{
+		0, 0, 8, 8, 10, 12, 14,
+		12, 16, 12, 14, 8
+	};
+	
+	// Control addressing modes (JMP, JSR, LEA, PEA), in the same order
+	
+	static const uint8_t jmp_cycles[] = { 0, 0,  8, 0, 0, 10, 14, 10, 12, 10, 14, 0 };
+	static const uint8_t jsr_cycles[] = { 0, 0, 16, 0, 0, 18, 22, 18, 20, 18, 22, 0 };
+	static const uint8_t lea_cycles[] = { 0, 0,  4, 0, 0,  8, 12,  8, 12,  8, 12, 0 };
+	static const uint8_t pea_cycles[] = { 0, 0, 12, 0, 0, 16, 20, 16, 20, 16, 20, 0 };
+	
+	static inline
+	unsigned ea_index( unsigned mode, unsigned reg )
+	{
+		return mode < 7 ? mode
+		     : reg  < 5 ? 7 + reg
+		     :            7 + 4;
+	}
+	
+	static inline
+	unsigned ea_cycles( unsigned mode, unsigned reg, bool is_long )
+	{
+		const unsigned i = ea_index( mode, reg );
+		
+		return is_long ? ea_long_cycles[ i ] : ea_word_cycles[ i ];
+	}
+	
+	static inline
+	bool is_register_or_immediate( unsigned mode, unsigned reg )
+	{
+		return mode <= 1  ||  (mode == 7  &&  reg == 4);
+	}
+	
+	static
+	unsigned bit_op_cycles( uint16_t opcode, unsigned mode, unsigned reg )
+	{
+		const unsigned op = opcode >> 6 & 0x3;  // BTST, BCHG, BCLR, BSET
+		
+		const unsigned immediate = (opcode & 0x0100) ? 0 : 4;
+		
+		if ( mode == 0 )
+		{
+			return (op == 0 ? 6 : op == 2 ? 10 : 8) + immediate;
+		}
+		
+		return (op == 0 ? 4 : 8) + immediate + ea_cycles( mode, reg, false );
+	}
+	
+	static
+	unsigned immediate_op_cycles( uint16_t opcode, unsigned mode, unsigned reg, bool is_long )
+	{
+		if ( mode == 7  &&  reg == 4 )
+		{
+			return 20;  // to CCR or SR
+		}
+		
+		const bool is_cmp = (opcode & 0x0F00) == 0x0C00;
+		
+		if ( mode == 0 )
+		{
+			return is_long ? (is_cmp ? 14 : 16) : 8;
+		}
+		
+		return (is_long ? (is_cmp ? 12 : 20) : (is_cmp ? 8 : 12))
+		       + ea_cycles( mode, reg, is_long );
+	}
+	
+	static
+	unsigned line_4_cycles( uint16_t opcode, unsigned mode, unsigned reg, bool is_long )
+	{
+		const unsigned ea = ea_cycles( mode, reg, is_long );
+		
+		switch ( opcode )
+		{
+			case 0x4AFC:  return 4;  // ILLEGAL, plus exception processing
+			case 0x4E70:  return 132;  // RESET
+			case 0x4E71:  return 4;  // NOP
+			case 0x4E72:  return 4;  // STOP
+			case 0x4E73:  return 20;  // RTE
+			case 0x4E75:  return 16;  // RTS
+			case 0x4E76:  return 4;  // TRAPV
+			case 0x4E77:  return 20;  // RTR
+			
+			default:
+				break;
+		}
+		
+		const unsigned i = ea_index( mode, reg );
+		
+		switch ( opcode & 0xFFC0 )
+		{
+			case 0x4E80:  return jsr_cycles[ i ];
+			case 0x4EC0:  return jmp_cycles[ i ];
+			
+			case 0x4E40:
+				// TRAP, LINK, UNLK, MOVE USP
+				return mode <= 1 ? 0 : mode == 2 ? 16 : mode == 3 ? 12 : 4;
+			
+			case 0x4840:
+				// SWAP, BKPT, PEA
+				return mode <= 1 ? 4 : pea_cycles[ i ];
+			
+			case 0x4880:
+			case 0x48C0:
+				// EXT, MOVEM to memory
+				return mode == 0 ? 4 : 8 + ea;
+			
+			case 0x4C80:
+			case 0x4CC0:
+				// MOVEM from memory
+				return 12 + ea;
+			
+			case 0x40C0:
+				// MOVE from SR
+				return mode == 0 ? 6 : 8 + ea;
+			
+			case 0x44C0:
+			case 0x46C0:
+				// MOVE to CCR, MOVE to SR
+				return 12 + ea;
+			
+			case 0x4800:
+				// NBCD
+				return mode == 0 ? 6 : 8 + ea;
+			
+			case 0x4AC0:
+				// TAS
+				return mode == 0 ? 4 : 14 + ea;
+			
+			default:
+				break;
+		}
+		
+		if ( (opcode & 0xF1C0) == 0x41C0  &&  mode >= 2 )
+		{
+			return lea_cycles[ i ];
+		}
+		
+		if ( (opcode & 0xF1C0) == 0x4180 )
+		{
+			return 10 + ea;  // CHK
+		}
+		
+		if ( (opcode & 0xFF00) == 0x4A00 )
+		{
+			return 4 + ea;  // TST
+		}
+		
+		// CLR, NEG, NEGX, NOT
+		
+		return mode == 0 ? (is_long ? 6 : 4) : (is_long ? 12 : 8) + ea;
+	}
+	
+	static
+	unsigned alu_cycles( uint16_t opcode, unsigned mode, unsigned reg, bool is_long )
+	{
+		// ADD, SUB, AND, OR, CMP, EOR (and their address/extended forms)
+		
+		const unsigned line   = opcode >> 12;
+		const unsigned opmode = opcode >> 6 & 0x7;
+		
+		const unsigned ea = ea_cycles( mode, reg, is_long );
+		
+		if ( opmode == 3  ||  opmode == 7 )
+		{
+			switch ( line )
+			{
+				case 0x8:  return (opmode == 3 ? 140 : 158) + ea;  // DIVU, DIVS
+				case 0xC:  return 70 + ea;  // MULU, MULS
+				case 0xB:  return 6 + ea;  // CMPA
+				
+				default:
+					// ADDA, SUBA
+					
+					if ( is_long  &&  ! is_register_or_immediate( mode, reg ) )
+					{
+						return 6 + ea;
+					}
+					
+					return 8 + ea;
+			}
+		}
+		
+		if ( opmode >= 4  &&  mode <= 1 )
+		{
+			if ( line == 0xB )
+			{
+				// EOR to Dn, CMPM
+				
+				return mode == 0 ? (is_long ? 8 : 4) : (is_long ? 20 : 12);
+			}
+			
+			if ( line == 0xC  &&  (opcode & 0x01F0) != 0x0100 )
+			{
+				return 6;  // EXG
+			}
+			
+			// ABCD, SBCD, ADDX, SUBX
+			
+			const bool is_bcd = line == 0x8  ||  line == 0xC;
+			
+			if ( mode == 0 )
+			{
+				return is_bcd ? 6 : is_long ? 8 : 4;
+			}
+			
+			return is_bcd ? 18 : is_long ? 30 : 18;
+		}
+		
+		if ( opmode >= 4 )
+		{
+			return (is_long ? 12 : 8) + ea;  // Dn,<ea>, EOR
+		}
+		
+		if ( is_long )
+		{
+			const bool fast = is_register_or_immediate( mode, reg )  &&  line != 0xB;
+			
+			return (fast ? 8 : 6) + ea;
+		}
+		
+		return 4 + ea;
+	}
+	
+	static
+	unsigned shift_cycles( uint16_t opcode, unsigned mode, unsigned reg, bool is_long )
+	{
+		if ( (opcode & 0x00C0) == 0x00C0 )
+		{
+			return 8 + ea_cycles( mode, reg, false );  // memory, by one bit
+		}
+		
+		unsigned count = 0;  // unknown, if held in a register
+		
+		if ( (opcode & 0x0020) == 0 )
+		{
+			count = opcode >> 9 & 0x7;
+			
+			count += (count == 0) * 8;
+		}
+		
+		return (is_long ? 8 : 6) + 2 * count;
+	}
+	
+	instruction_timing timing_of( uint16_t opcode, op_size_t size )
+	{
+		const unsigned mode = opcode >> 3 & 0x7;
+		const unsigned reg  = opcode      & 0x7;
+		
+		const bool is_long = size == long_sized;
+		
+		unsigned cycles = 0;
+		unsigned taken  = 0;
+		
+		switch ( opcode >> 12 )
+		{
+			case 0x0:
+				if ( (opcode & 0x0100)  &&  mode == 1 )
+				{
+					cycles = is_long ? 24 : 16;  // MOVEP
+				}
+				else if ( (opcode & 0x0100)  ||  (opcode & 0x0F00) == 0x0800 )
+				{
+					cycles = bit_op_cycles( opcode, mode, reg );
+				}
+				else
+				{
+					cycles = immediate_op_cycles( opcode, mode, reg, is_long );
+				}
+				
+				break;
+			
+			case 0x1:
+			case 0x2:
+			case 0x3:
+				{
+					// MOVE, MOVEA:  predecrement costs no more than indirect here
+					
+					unsigned dst_mode = opcode >> 6 & 0x7;
+					unsigned dst_reg  = opcode >> 9 & 0x7;
+					
+					dst_mode -= dst_mode == 4;
+					
+					cycles = 4 + ea_cycles( mode,     reg,     is_long )
+					           + ea_cycles( dst_mode, dst_reg, is_long );
+				}
+				
+				break;
+			
+			case 0x4:
+				cycles = line_4_cycles( opcode, mode, reg, is_long );
+				break;
+			
+			case 0x5:
+				if ( (opcode & 0x00C0) != 0x00C0 )
+				{
+					// ADDQ, SUBQ
+					
+					cycles = mode == 0 ? (is_long ? 8 : 4)
+					       : mode == 1 ? 8
+					       :             (is_long ? 12 : 8) + ea_cycles( mode, reg, is_long );
+				}
+				else if ( mode == 1 )
+				{
+					cycles = 14;  // DBcc, counter expired
+					taken  = 10;
+				}
+				else
+				{
+					cycles = mode == 0 ? 6 : 8 + ea_cycles( mode, reg, false );  // Scc
+				}
+				
+				break;
+			
+			case 0x6:
+				switch ( opcode >> 8 & 0xF )
+				{
+					case 0:  cycles = 10;  break;  // BRA
+					case 1:  cycles = 18;  break;  // BSR
+					
+					default:
+						cycles = (opcode & 0xFF) ? 8 : 12;
+						taken  = 10;
+						break;
+				}
+				
+				break;
+			
+			case 0x7:
+				cycles = 4;  // MOVEQ
+				break;
+			
+			case 0x8:
+			case 0x9:
+			case 0xB:
+			case 0xC:
+			case 0xD:
+				cycles = alu_cycles( opcode, mode, reg, is_long );
+				break;
+			
+			case 0xE:
+				cycles = shift_cycles( opcode, mode, reg, is_long );
+				break;
+			
+			default:
+				break;
+		}
+		
+		instruction_timing timing = { uint16_t( cycles ), uint16_t( taken ? taken : cycles ) };
+		
+		return timing;
+	}
+	
+}
@@ -0,0 +1,50 @@
+/*
+	timing.hh
+	---------
+*/
+
+#ifndef V68K_TIMING_HH
+#define V68K_TIMING_HH
+
+// C99
+#include <stdint.h>
+
+// v68k
+#include "v68k/op_params.hh"
+
+
+namespace v68k
+{
+	
+	/*
+		Approximate MC68000 clock periods for an instruction, from the
+		opcode alone:  a base time for the operation plus the effective
+		address calculation time of its operands.
+		
+		`cycles` is the cost when execution falls through to the next
+		instruction, and `taken_cycles` the cost when it doesn't (a taken
+		branch, or a DBcc that loops).  They're the same for everything
+		other than conditional branches.
+		
+		Counts that depend on run-time data -- the number of registers moved
+		by MOVEM, a shift count held in a register, the operands of MULU and
+		DIVU -- aren't modeled, nor is wait-state or prefetch overlap.  The
+		68000 times are used for every processor model.
+	*/
+	
+	struct instruction_timing
+	{
+		uint16_t  cycles;
+		uint16_t  taken_cycles;
+	};
+	
+	instruction_timing timing_of( uint16_t opcode, op_size_t size );
+	
+	enum
+	{
+		exception_processing_cycles = 34
+	};
+	
+}
+
+#endif